@@ -9,6 +9,8 @@
 #include <openssl/crypto.h>
 #include <cstring>
 #include <cerrno>
+#include <mutex>
+#include <new>
 
 #if defined(_WIN32)
 #include <windows.h>
@@ -106,6 +108,59 @@ inline bool Ed25519_ValidateDetached(const uint8_t* signature, int signatureLeng
 	return ok;
 }
 
+// Validates count detached signatures, sharing one digest context across the batch and keeping the most recently
+// used public keys decoded, since the witnesses of a block tend to repeat a few validator keys. Returns how many
+// signatures are valid.
+inline int Ed25519_ValidateDetachedBatch(const uint8_t* const* signatures, const uint8_t* const* messages, const int* messageLengths, const uint8_t* const* publicKeys, int count, bool* results)
+{
+	struct CachedKey
+	{
+		uint8_t bytes[32];
+		EVP_PKEY* pkey;
+	};
+	constexpr int CacheSize = 8;
+	CachedKey cache[CacheSize];
+	int cached = 0;
+
+	EVP_MD_CTX* ctx = EVP_MD_CTX_new();
+	int valid = 0;
+	for( int i = 0; i < count; ++i )
+	{
+		const uint8_t* publicKey = publicKeys[i];
+		results[i] = false;
+		if( !ctx || !signatures[i] || !messages[i] || messageLengths[i] < 0 || !publicKey )
+			continue;
+
+		int slot = 0;
+		while( slot < cached && memcmp(cache[slot].bytes, publicKey, 32) != 0 )
+			++slot;
+		if( slot == cached )
+		{
+			EVP_PKEY* pkey = EVP_PKEY_new_raw_public_key(EVP_PKEY_ED25519, nullptr, publicKey, 32);
+			if( !pkey )
+				continue;
+			if( cached == CacheSize )
+				EVP_PKEY_free(cache[--cached].pkey);
+			slot = cached++;
+			memcpy(cache[slot].bytes, publicKey, 32);
+			cache[slot].pkey = pkey;
+		}
+		// Move to the front, so the least recently used key is the one evicted
+		const CachedKey hit = cache[slot];
+		memmove(cache + 1, cache, sizeof(CachedKey) * (size_t)slot);
+		cache[0] = hit;
+
+		EVP_MD_CTX_reset(ctx);
+		results[i] = EVP_DigestVerifyInit(ctx, nullptr, nullptr, nullptr, hit.pkey) == 1 &&
+		             EVP_DigestVerify(ctx, signatures[i], 64, messages[i], (size_t)messageLengths[i]) == 1;
+		valid += results[i];
+	}
+	for( int i = 0; i < cached; ++i )
+		EVP_PKEY_free(cache[i].pkey);
+	EVP_MD_CTX_free(ctx);
+	return valid;
+}
+
 inline bool Ed25519_ValidateAttached(const uint8_t* signedMessage, int signedMessageLength, const uint8_t* publicKey, int publicKeyLength)
 {
 	if( !signedMessage || signedMessageLength < 64 || !publicKey || publicKeyLength != 32 )
@@ -158,6 +213,79 @@ inline int Phantasma_UnlockMemory(void* pointer, size_t size)
 #define PHANTASMA_SECURE_READWRITE(ptr, size) ((void)(ptr), (void)(size), 0)
 #endif
 
+// A signing key decoded once (which derives its public key) and kept for every signature made with it, along with
+// a digest context. A thread that finds the context busy signs with a temporary one instead of waiting. OpenSSL only
+// keeps the private key itself in its secure heap once the application has called CRYPTO_secure_malloc_init, and in
+// ordinary heap memory otherwise; the wrapper goes in PHANTASMA_SECURE_ALLOC memory.
+struct Ed25519_Signer
+{
+	EVP_PKEY* pkey;
+	EVP_MD_CTX* ctx;
+	std::mutex mutex;
+};
+
+inline void* Ed25519_SignerCreate(const uint8_t* seed, int seedLength)
+{
+	if( !seed || seedLength != 32 )
+	{
+		return nullptr;
+	}
+	EVP_PKEY* pkey = EVP_PKEY_new_raw_private_key(EVP_PKEY_ED25519, nullptr, seed, 32);
+	if( !pkey )
+	{
+		return nullptr;
+	}
+	void* memory = PHANTASMA_SECURE_ALLOC(sizeof(Ed25519_Signer));
+	if( !memory )
+	{
+		EVP_PKEY_free(pkey);
+		return nullptr;
+	}
+	Ed25519_Signer* signer = new( memory ) Ed25519_Signer;
+	signer->pkey = pkey;
+	signer->ctx = EVP_MD_CTX_new();
+	return signer;
+}
+
+inline void Ed25519_SignerFree(void* context)
+{
+	Ed25519_Signer* signer = (Ed25519_Signer*)context;
+	if( !signer )
+	{
+		return;
+	}
+	EVP_MD_CTX_free(signer->ctx);
+	EVP_PKEY_free(signer->pkey);
+	signer->~Ed25519_Signer();
+	PHANTASMA_SECURE_FREE(signer);
+}
+
+inline uint64_t Ed25519_SignerSign(void* context, uint8_t* output, int outputLength, const uint8_t* message, int messageLength)
+{
+	Ed25519_Signer* signer = (Ed25519_Signer*)context;
+	if( !signer || !output || outputLength < 64 || !message || messageLength < 0 )
+	{
+		return 0;
+	}
+	std::unique_lock<std::mutex> lock(signer->mutex, std::try_to_lock);
+	EVP_MD_CTX* ctx = lock.owns_lock() && signer->ctx ? signer->ctx : EVP_MD_CTX_new();
+	size_t siglen = (size_t)outputLength;
+	if( !ctx || EVP_DigestSignInit(ctx, nullptr, nullptr, nullptr, signer->pkey) != 1 ||
+	    EVP_DigestSign(ctx, output, &siglen, message, (size_t)messageLength) != 1 )
+	{
+		siglen = 0;
+	}
+	if( ctx == signer->ctx )
+	{
+		EVP_MD_CTX_reset(ctx);
+	}
+	else
+	{
+		EVP_MD_CTX_free(ctx);
+	}
+	return siglen;
+}
+
 #define PHANTASMA_RANDOMBYTES(buffer, size) RAND_bytes((unsigned char*)(buffer), (int)(size))
 #define PHANTASMA_WIPEMEM(buffer, size) OPENSSL_cleanse((buffer), (size))
 
@@ -176,6 +304,12 @@ inline int Phantasma_UnlockMemory(void* pointer, size_t size)
 	Ed25519_ValidateAttached(message, messageLength, publicKey, publicKeyLength)
 #define PHANTASMA_Ed25519_ValidateDetached(signature, signatureLength, message, messageLength, publicKey, publicKeyLength) \
 	Ed25519_ValidateDetached(signature, signatureLength, message, messageLength, publicKey, publicKeyLength)
+#define PHANTASMA_Ed25519_ValidateDetachedBatch(signatures, messages, messageLengths, publicKeys, count, results) \
+	Ed25519_ValidateDetachedBatch(signatures, messages, messageLengths, publicKeys, count, results)
+#define PHANTASMA_Ed25519_SignerCreate(seed, seedLength) Ed25519_SignerCreate(seed, seedLength)
+#define PHANTASMA_Ed25519_SignerSign(context, output, outputLength, message, messageLength) \
+	Ed25519_SignerSign(context, output, outputLength, message, messageLength)
+#define PHANTASMA_Ed25519_SignerFree(context) Ed25519_SignerFree(context)
 
 inline void Phantasma_SHA256(Byte* output, int outputSize, const Byte* input, int inputSize)
 {
@@ -183,5 +317,59 @@ inline void Phantasma_SHA256(Byte* output, int outputSize, const Byte* input, in
 	::SHA256(reinterpret_cast<const unsigned char*>(input), (size_t)inputSize, reinterpret_cast<unsigned char*>(output));
 }
 #define PHANTASMA_SHA256(output, outputSize, input, inputSize) ::phantasma::Phantasma_SHA256((Byte*)(output), (int)(outputSize), (const Byte*)(input), (int)(inputSize))
+#define PHANTASMA_SHA256_BUILTIN
+
+// The SHA256_CTX functions are deprecated in OpenSSL 3 in favour of EVP_MD_CTX, which cannot export a hash in progress
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+#elif defined(_MSC_VER)
+#pragma warning(push)
+#pragma warning(disable : 4996)
+#endif
+inline void Phantasma_SHA256_Init(SHA256_CTX& state)
+{
+	SHA256_Init(&state);
+}
+inline void Phantasma_SHA256_Update(SHA256_CTX& state, const Byte* input, size_t inputSize)
+{
+	SHA256_Update(&state, input, inputSize);
+}
+inline void Phantasma_SHA256_Final(SHA256_CTX& state, Byte* output)
+{
+	SHA256_Final(output, &state);
+}
+// OpenSSL keeps the message length in bits, split over Nl/Nh, and the unprocessed bytes at the start of data
+template<class Midstate>
+void Phantasma_SHA256_Export(const SHA256_CTX& state, Midstate& midstate)
+{
+	for( int i = 0; i < 8; ++i )
+		midstate.state[i] = state.h[i];
+	midstate.length = ((((UInt64)state.Nh << 32) | state.Nl) >> 3);
+	memcpy(midstate.buffer, state.data, (size_t)(midstate.length % 64));
+}
+template<class Midstate>
+void Phantasma_SHA256_Import(SHA256_CTX& state, const Midstate& midstate)
+{
+	SHA256_Init(&state);
+	for( int i = 0; i < 8; ++i )
+		state.h[i] = midstate.state[i];
+	state.Nl = (SHA_LONG)(midstate.length << 3);
+	state.Nh = (SHA_LONG)(midstate.length >> 29);
+	state.num = (unsigned int)(midstate.length % 64);
+	memcpy(state.data, midstate.buffer, state.num);
+}
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic pop
+#elif defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#define PHANTASMA_SHA256_STATE SHA256_CTX
+#define PHANTASMA_SHA256_INIT(state) ::phantasma::Phantasma_SHA256_Init(state)
+#define PHANTASMA_SHA256_UPDATE(state, input, inputSize) ::phantasma::Phantasma_SHA256_Update(state, input, inputSize)
+#define PHANTASMA_SHA256_FINAL(state, output) ::phantasma::Phantasma_SHA256_Final(state, output)
+#define PHANTASMA_SHA256_EXPORT(state, midstate) ::phantasma::Phantasma_SHA256_Export(state, midstate)
+#define PHANTASMA_SHA256_IMPORT(state, midstate) ::phantasma::Phantasma_SHA256_Import(state, midstate)
 
 } // namespace phantasma
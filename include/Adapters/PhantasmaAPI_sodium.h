@@ -15,6 +15,7 @@
 #include "sodium/crypto_sign_ed25519.h"
 #include "sodium/crypto_secretbox.h"
 #include "sodium/crypto_pwhash.h"
+#include <cstring>
 
 namespace phantasma {
 
@@ -116,6 +117,24 @@ inline bool Phantasma_PasswordToKey(Byte* output, const char* password, int pass
 	                crypto_pwhash_argon2id_MEMLIMIT_MODERATE, crypto_pwhash_ALG_DEFAULT);
 }
 
+// libsodium keeps the message length in bits and the unprocessed bytes at the start of buf
+template<class Midstate>
+void Phantasma_SHA256_Export(const crypto_hash_sha256_state& state, Midstate& midstate)
+{
+	for( int i = 0; i < 8; ++i )
+		midstate.state[i] = state.state[i];
+	midstate.length = state.count >> 3;
+	memcpy(midstate.buffer, state.buf, (size_t)(midstate.length % 64));
+}
+template<class Midstate>
+void Phantasma_SHA256_Import(crypto_hash_sha256_state& state, const Midstate& midstate)
+{
+	for( int i = 0; i < 8; ++i )
+		state.state[i] = midstate.state[i];
+	state.count = midstate.length << 3;
+	memcpy(state.buf, midstate.buffer, (size_t)(midstate.length % 64));
+}
+
 #define PHANTASMA_RANDOMBYTES(buffer, size) randombytes_buf(buffer, size)
 #define PHANTASMA_WIPEMEM(buffer, size) sodium_memzero(buffer, size)
 
@@ -142,6 +161,13 @@ inline bool Phantasma_PasswordToKey(Byte* output, const char* password, int pass
 	Ed25519_ValidateDetached(signature, signatureLength, message, messageLength, publicKey, publicKeyLength)
 
 #define PHANTASMA_SHA256(output, outputSize, input, inputSize) crypto_hash_sha256(output, input, inputSize)
+#define PHANTASMA_SHA256_BUILTIN
+#define PHANTASMA_SHA256_STATE crypto_hash_sha256_state
+#define PHANTASMA_SHA256_INIT(state) crypto_hash_sha256_init(&(state))
+#define PHANTASMA_SHA256_UPDATE(state, input, inputSize) crypto_hash_sha256_update(&(state), input, inputSize)
+#define PHANTASMA_SHA256_FINAL(state, output) crypto_hash_sha256_final(&(state), output)
+#define PHANTASMA_SHA256_EXPORT(state, midstate) Phantasma_SHA256_Export(state, midstate)
+#define PHANTASMA_SHA256_IMPORT(state, midstate) Phantasma_SHA256_Import(state, midstate)
 
 #define PHANTASMA_AuthenticatedEncrypt Phantasma_Encrypt
 #define PHANTASMA_AuthenticatedDecrypt Phantasma_Decrypt
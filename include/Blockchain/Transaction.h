@@ -1,6 +1,10 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 #include "../Cryptography/SHA.h"
+#include "../Cryptography/SHA256Core.h"
 #include "../Cryptography/Hash.h"
 #include "../Cryptography/Signature.h"
 #include "../Cryptography/KeyPair.h"
@@ -19,6 +23,9 @@ class Transaction : public Serializable
 	String m_chainName;
 	PHANTASMA_VECTOR<Signature> m_signatures;
 	Hash m_hash;
+	// ToByteArray(false), which is what gets signed and hashed. Built by every constructor and refreshed by UpdateHash
+	// whenever the fields above change, so const methods only read it and can run from several threads.
+	ByteArray m_message;
 	struct StringToByteHelper {
 		StringToByteHelper() = default;
 		ByteArray buffer;
@@ -75,6 +82,7 @@ class Transaction : public Serializable
 
 	Transaction()
 	{
+		UpdateMessage();
 	}
 
 	Transaction(const Char* nexusName, const Char* chainName, const ByteArray& script, Timestamp expiration, const String& payload, StringToByteHelper temp = StringToByteHelper())
@@ -93,6 +101,7 @@ class Transaction : public Serializable
 	{
 		if( script.empty() )
 		{
+			UpdateMessage();
 			PHANTASMA_EXCEPTION("null script in transaction");
 			return;
 		}
@@ -108,11 +117,19 @@ class Transaction : public Serializable
 
 	ByteArray ToByteArray(bool withSignature) const
 	{
+		if( !withSignature )
+			return UnsignedBytes();
 		BinaryWriter writer;
 		Serialize(writer, withSignature);
 		return writer.ToArray();
 	}
 
+	// The serialized transaction without its signatures, i.e. the message that signatures are made over
+	const ByteArray& UnsignedBytes() const
+	{
+		return m_message;
+	}
+
 	//	String ToRawTransaction() const
 	//	{
 	//		return Base16::Encode(ToByteArray(true));
@@ -126,24 +143,24 @@ class Transaction : public Serializable
 	template<class IKeyPair>
 	void Sign(const IKeyPair& keypair)
 	{
-		auto msg = ToByteArray(false);
+		const ByteArray& msg = UnsignedBytes();
 
 		//m_signatures.clear();
 		m_signatures.push_back(Signature{ keypair.Sign(msg) });
 	}
 
-	bool IsSignedBy(Address address)
+	bool IsSignedBy(Address address) const
 	{
 		return IsSignedBy(&address, 1);
 	}
-	int SignatureIndex(const Address& address)
+	int SignatureIndex(const Address& address) const
 	{
 		if( !HasSignatures() )
 		{
 			return -1;
 		}
 
-		auto msg = ToByteArray(false);
+		const ByteArray& msg = UnsignedBytes();
 
 		for( int i = 0, end = (int)m_signatures.size(); i != end; ++i )
 		{
@@ -156,14 +173,14 @@ class Transaction : public Serializable
 		return -1;
 	}
 
-	bool IsSignedBy(const Address* addresses, int numAddresses)
+	bool IsSignedBy(const Address* addresses, int numAddresses) const
 	{
 		if( !HasSignatures() )
 		{
 			return false;
 		}
 
-		auto msg = ToByteArray(false);
+		const ByteArray& msg = UnsignedBytes();
 
 		for( const auto& signature : m_signatures )
 		{
@@ -183,11 +200,16 @@ class Transaction : public Serializable
 	}
 
   private:
+	void UpdateMessage()
+	{
+		BinaryWriter writer;
+		Serialize(writer, false);
+		m_message = writer.ToArray();
+	}
 	void UpdateHash()
 	{
-		auto data = ToByteArray(false);
-		auto hash = SHA256(data);
-		m_hash = Hash(hash);
+		UpdateMessage();
+		m_hash = Hash(SHA256(m_message));
 	}
 
   public:
@@ -226,12 +248,15 @@ class Transaction : public Serializable
 	}
 
 	template<class ProofOfWork>
-	void Mine(ProofOfWork targetDifficulty)
+	void Mine(ProofOfWork targetDifficulty, int numThreads = 1)
 	{
-		Mine((int)targetDifficulty);
+		Mine((int)targetDifficulty, numThreads);
 	}
 
-	bool Mine(int targetDifficulty)
+	// Appends a nonce to the payload so that the hash has at least targetDifficulty leading zero bits. The nonce space
+	// is split between numThreads threads (including the calling one; 0 picks one per hardware thread), and the
+	// smallest nonce that works is kept, so the result does not depend on the number of threads.
+	bool Mine(int targetDifficulty, int numThreads = 1)
 	{
 		if( targetDifficulty < 0 || targetDifficulty > 256 )
 		{
@@ -244,47 +269,108 @@ class Transaction : public Serializable
 			return false;
 		}
 
-		if( targetDifficulty == 0 )
+		if( targetDifficulty == 0 || GetHash().GetDifficulty() >= targetDifficulty )
 		{
 			return true; // no mining necessary
 		}
 
-		UInt32 nonce = 0;
-
-		UInt32 payloadSize = 4;
+		// Room for the nonce: four bytes, after a separator byte when there already is a payload
+		const int payloadSize = m_payload.empty() ? 4 : (int)m_payload.size() + 5;
+		m_payload.resize(payloadSize);
+		UpdateHash();
 
-		while( true )
+		const UInt32 nonce = FindNonce(UnsignedBytes(), targetDifficulty, numThreads);
+		if( nonce == 0 )
 		{
-			if( GetHash().GetDifficulty() >= targetDifficulty )
-			{
-				return true;
-			}
+			PHANTASMA_EXCEPTION("Transaction mining failed");
+			return false;
+		}
+
+		m_payload[payloadSize - 4] = (Byte)((nonce >> 0) & 0xFF);
+		m_payload[payloadSize - 3] = (Byte)((nonce >> 8) & 0xFF);
+		m_payload[payloadSize - 2] = (Byte)((nonce >> 16) & 0xFF);
+		m_payload[payloadSize - 1] = (Byte)((nonce >> 24) & 0xFF);
+		UpdateHash();
+		return true;
+	}
 
-			if( nonce == 0 )
+  private:
+	// Nonces are handed out to the mining threads in ranges of this many
+	static constexpr UInt32 NonceRange = 4096;
+	static constexpr UInt64 NoNonce = 1ull << 32;
+
+	struct NonceSearch
+	{
+		// The message ends with the nonce. Every whole block before it is hashed once, into midstate; each attempt
+		// only compresses the padded tail.
+		UInt32 midstate[Sha256::StateWords];
+		Byte tail[2 * Sha256::BlockLength];
+		int tailBlocks;
+		int nonceOffset;
+		int target;
+		std::atomic<UInt64> next{ 1 };
+		std::atomic<UInt64> best{ NoNonce };
+	};
+
+	// Returns the smallest nonce from 1 upwards whose hash reaches target, or 0 if there is none
+	static UInt32 FindNonce(const ByteArray& message, int target, int numThreads)
+	{
+		NonceSearch search;
+		const int prefixBlocks = ((int)message.size() - 4) / Sha256::BlockLength;
+		const int tailLength = (int)message.size() - prefixBlocks * Sha256::BlockLength;
+		Sha256::Init(search.midstate);
+		Sha256::Compress(search.midstate, &message.front(), (size_t)prefixBlocks);
+		PHANTASMA_COPY(message.begin() + prefixBlocks * Sha256::BlockLength, message.end(), search.tail);
+		search.tailBlocks = Sha256::Pad(search.tail, tailLength, message.size());
+		search.nonceOffset = tailLength - 4;
+		search.target = target;
+
+		if( numThreads <= 0 )
+			numThreads = (int)PHANTASMA_MAX(1u, std::thread::hardware_concurrency());
+		PHANTASMA_VECTOR<std::thread> workers;
+		workers.reserve(numThreads - 1);
+		for( int i = 1; i < numThreads; ++i )
+			workers.emplace_back([&search]() { SearchNonces(search); });
+		SearchNonces(search);
+		for( std::thread& worker : workers )
+			worker.join();
+
+		const UInt64 best = search.best.load();
+		return best == NoNonce ? 0 : (UInt32)best;
+	}
+
+	static void SearchNonces(NonceSearch& search)
+	{
+		Byte tail[sizeof(search.tail)];
+		PHANTASMA_COPY(search.tail, search.tail + sizeof(tail), tail);
+		for( ;; )
+		{
+			// A range is only skipped once a smaller nonce has been found, which keeps the result the smallest one
+			const UInt64 begin = search.next.fetch_add(NonceRange, std::memory_order_relaxed);
+			if( begin >= search.best.load(std::memory_order_relaxed) )
+				return;
+			const UInt64 end = PHANTASMA_MIN(begin + NonceRange, NoNonce);
+			for( UInt64 nonce = begin; nonce < end; ++nonce )
 			{
-				if( m_payload.empty() )
-				{
-					m_payload = ByteArray(4);
-				}
-				else
+				Byte* n = tail + search.nonceOffset;
+				n[0] = (Byte)nonce;
+				n[1] = (Byte)(nonce >> 8);
+				n[2] = (Byte)(nonce >> 16);
+				n[3] = (Byte)(nonce >> 24);
+				UInt32 state[Sha256::StateWords];
+				PHANTASMA_COPY(search.midstate, search.midstate + Sha256::StateWords, state);
+				Sha256::Compress(state, tail, (size_t)search.tailBlocks);
+				Byte digest[Sha256::DigestLength];
+				Sha256::StoreDigest(digest, state);
+				if( Hash::Difficulty(digest) >= search.target )
 				{
-					payloadSize = m_payload.size() + 5;
-					m_payload.resize(payloadSize);
+					UInt64 best = search.best.load(std::memory_order_relaxed);
+					while( nonce < best && !search.best.compare_exchange_weak(best, nonce, std::memory_order_relaxed) )
+					{
+					}
+					break;
 				}
 			}
-
-			nonce++;
-			if( nonce == 0 )
-			{
-				PHANTASMA_EXCEPTION("Transaction mining failed");
-				return false;
-			}
-
-			m_payload[payloadSize - 4] = (Byte)((nonce >> 0) & 0xFF);
-			m_payload[payloadSize - 3] = (Byte)((nonce >> 8) & 0xFF);
-			m_payload[payloadSize - 2] = (Byte)((nonce >> 16) & 0xFF);
-			m_payload[payloadSize - 1] = (Byte)((nonce >> 24) & 0xFF);
-			UpdateHash();
 		}
 	}
 };
@@ -9,9 +9,12 @@
 #include <inttypes.h>
 #include <cstdarg>
 #include <cstdio>
+#include <atomic>
 #include <cstring>
+#include <deque>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <type_traits>
 #include <typeinfo>
 #include <unordered_map>
@@ -21,6 +24,15 @@
 #define CARBON_MEMORY_CLEAR 1 // Fill all allocation with fixed bitpatterns before and after use
 #define CARBON_MEMORY_BULK_ALLOCATION 1 // Pre-allocate larger buffers so multiple objects can share each allocation
 #define CARBON_MEMORY_STD_ALLOCATOR 1 // Track allocations that are performed by the standard library
+#ifndef CARBON_MEMORY_POOL
+#define CARBON_MEMORY_POOL 1 // Recycle arena chunks through a thread-local pool instead of returning them to the heap
+#endif
+#ifndef CARBON_MEMORY_POOL_MAX_CHUNKS
+#define CARBON_MEMORY_POOL_MAX_CHUNKS 16 // Upper bound on how many free chunks the pool retains per size class, per thread
+#endif
+#ifndef CARBON_MEMORY_TELEMETRY
+#define CARBON_MEMORY_TELEMETRY 1 // Keep cheap per-tag arena counters that can be inspected in release builds
+#endif
 
 #define CARBON_MEMORY_DBG(x) x
 #define CARBON_MEMORY_DBGC(x) , x
@@ -236,21 +248,343 @@ inline AllocLog& GetAllocLog()
 	return m;
 }
 
+// Release-mode counters for every Allocator tag. Allocators only touch these when they acquire a chunk or are cleared,
+// so the cost per allocation is a single local add.
+struct AllocTagStats {
+	explicit AllocTagStats(const char* name) : tag(name) {}
+
+	const std::string tag;
+	std::atomic<uint64_t> allocators{ 0 }; // number of Allocators constructed with this tag
+	std::atomic<uint64_t> bytesRequested{ 0 }; // bytes handed out by Alloc/Clone
+	std::atomic<uint64_t> bytesPadding{ 0 }; // bytes skipped to satisfy alignment
+	std::atomic<uint64_t> bytesSlack{ 0 }; // bytes left unused at the tail of chunks when they were cleared
+	std::atomic<uint64_t> chunksAllocated{ 0 };
+	std::atomic<uint64_t> chunksLive{ 0 };
+	std::atomic<uint64_t> chunkBytesLive{ 0 };
+	std::atomic<uint64_t> chunkBytesPeak{ 0 }; // high-water mark of chunkBytesLive
+	std::atomic<uint64_t> arenaBytesPeak{ 0 }; // most bytes any single Allocator consumed between two clears
+	std::atomic<uint64_t> clears{ 0 };
+
+	static void StoreMax(std::atomic<uint64_t>& peak, uint64_t value)
+	{
+		uint64_t prev = peak.load(std::memory_order_relaxed);
+		while( prev < value && !peak.compare_exchange_weak(prev, value, std::memory_order_relaxed) )
+		{
+		}
+	}
+};
+
+// Plain copy of AllocTagStats, safe to hold on to and compare
+struct AllocStatsSnapshot {
+	std::string tag;
+	uint64_t allocators = 0;
+	uint64_t bytesRequested = 0;
+	uint64_t bytesPadding = 0;
+	uint64_t bytesSlack = 0;
+	uint64_t chunksAllocated = 0;
+	uint64_t chunksLive = 0;
+	uint64_t chunkBytesLive = 0;
+	uint64_t chunkBytesPeak = 0;
+	uint64_t arenaBytesPeak = 0;
+	uint64_t clears = 0;
+};
+
+class AllocTelemetry
+{
+	std::mutex m;
+	std::deque<AllocTagStats> tags; // deque so that pointers held by Allocators stay valid as tags are added
+
+  public:
+	// Finds or creates the counters for a tag. Tags are compared by content. The last lookup on each thread is cached,
+	// and a hit at the same address is confirmed against the cached tag's text, since a reused buffer can hold a new tag.
+	AllocTagStats& Tag(const char* tag)
+	{
+		if( !tag )
+			tag = "?";
+		thread_local const char* lastTag = nullptr;
+		thread_local AllocTagStats* lastStats = nullptr;
+		if( tag == lastTag && lastStats && lastStats->tag == tag )
+			return *lastStats;
+		std::lock_guard lk(m);
+		AllocTagStats* found = nullptr;
+		for( auto& i : tags )
+		{
+			if( i.tag == tag )
+			{
+				found = &i;
+				break;
+			}
+		}
+		if( !found )
+			found = &tags.emplace_back(tag);
+		lastTag = tag;
+		lastStats = found;
+		return *found;
+	}
+
+	std::vector<AllocStatsSnapshot> Snapshot()
+	{
+		std::vector<AllocStatsSnapshot> result;
+		std::lock_guard lk(m);
+		result.reserve(tags.size());
+		for( const auto& i : tags )
+		{
+			AllocStatsSnapshot& s = result.emplace_back();
+			s.tag = i.tag;
+			s.allocators = i.allocators.load(std::memory_order_relaxed);
+			s.bytesRequested = i.bytesRequested.load(std::memory_order_relaxed);
+			s.bytesPadding = i.bytesPadding.load(std::memory_order_relaxed);
+			s.bytesSlack = i.bytesSlack.load(std::memory_order_relaxed);
+			s.chunksAllocated = i.chunksAllocated.load(std::memory_order_relaxed);
+			s.chunksLive = i.chunksLive.load(std::memory_order_relaxed);
+			s.chunkBytesLive = i.chunkBytesLive.load(std::memory_order_relaxed);
+			s.chunkBytesPeak = i.chunkBytesPeak.load(std::memory_order_relaxed);
+			s.arenaBytesPeak = i.arenaBytesPeak.load(std::memory_order_relaxed);
+			s.clears = i.clears.load(std::memory_order_relaxed);
+		}
+		return result;
+	}
+
+	// Zeroes the cumulative counters and restarts the peaks from the current live values
+	void Reset()
+	{
+		std::lock_guard lk(m);
+		for( auto& i : tags )
+		{
+			i.allocators = 0;
+			i.bytesRequested = 0;
+			i.bytesPadding = 0;
+			i.bytesSlack = 0;
+			i.chunksAllocated = 0;
+			i.chunkBytesPeak = i.chunkBytesLive.load(std::memory_order_relaxed);
+			i.arenaBytesPeak = 0;
+			i.clears = 0;
+		}
+	}
+
+	std::string ToJson()
+	{
+		std::string json = "[";
+		char buffer[1024];
+		bool first = true;
+		for( const AllocStatsSnapshot& s : Snapshot() )
+		{
+			std::string tag;
+			for( size_t i = 0; i != s.tag.size() && i != 128; ++i )
+			{
+				const char c = s.tag[i];
+				if( c == '"' || c == '\\' )
+					tag.push_back('\\');
+				if( (unsigned char)c >= 0x20 )
+					tag.push_back(c);
+			}
+			snprintf(buffer, sizeof(buffer),
+			    "%s{\"tag\":\"%s\",\"allocators\":%" PRIu64 ",\"bytesRequested\":%" PRIu64 ",\"bytesPadding\":%" PRIu64
+			    ",\"bytesSlack\":%" PRIu64 ",\"chunksAllocated\":%" PRIu64 ",\"chunksLive\":%" PRIu64 ",\"chunkBytesLive\":%" PRIu64
+			    ",\"chunkBytesPeak\":%" PRIu64 ",\"arenaBytesPeak\":%" PRIu64 ",\"clears\":%" PRIu64 "}",
+			    first ? "" : ",", tag.c_str(), s.allocators, s.bytesRequested, s.bytesPadding,
+			    s.bytesSlack, s.chunksAllocated, s.chunksLive, s.chunkBytesLive,
+			    s.chunkBytesPeak, s.arenaBytesPeak, s.clears);
+			json += buffer;
+			first = false;
+		}
+		json += "]";
+		return json;
+	}
+};
+
+inline AllocTelemetry& GetAllocTelemetry()
+{
+	static AllocTelemetry m;
+	return m;
+}
+
+// Thread-local cache of the large buffers that back Allocator chunks.
+// Chunk sizes are rounded up to power-of-two size classes from 64KiB to 1MiB, so a chunk released by one Allocator
+// can be handed to the next one that asks for a similar size. Larger requests bypass the pool entirely.
+class ChunkPool
+{
+  public:
+	constexpr static size_t MinChunkSize = 64 * 1024;
+	constexpr static int NumClasses = 5;
+	constexpr static size_t MaxChunkSize = MinChunkSize << (NumClasses - 1);
+	constexpr static size_t MaxRetained = CARBON_MEMORY_POOL_MAX_CHUNKS;
+
+	ChunkPool() = default;
+	~ChunkPool()
+	{
+		Trim();
+		TornDown() = true;
+	}
+
+	// The size of the chunk that will be handed out for a request of the given size
+	static size_t RoundUp(size_t required)
+	{
+		if( required > MaxChunkSize )
+			return ((required + MinChunkSize - 1) / MinChunkSize) * MinChunkSize;
+		size_t size = MinChunkSize;
+		while( size < required )
+			size <<= 1;
+		return size;
+	}
+
+	// The pool for the calling thread, or null if that thread is already shutting down
+	static ChunkPool* Local()
+	{
+		if( TornDown() )
+			return nullptr;
+		thread_local ChunkPool pool;
+		return &pool;
+	}
+
+	// size must be a value returned by RoundUp
+	static uint8_t* Acquire(size_t size)
+	{
+#if CARBON_MEMORY_POOL
+		const int c = ClassOf(size);
+		ChunkPool* pool = c >= 0 ? Local() : nullptr;
+		if( pool && pool->m_count[c] )
+			return pool->m_free[c][--pool->m_count[c]];
+#endif
+		return new uint8_t[size];
+	}
+	static void Release(uint8_t* buffer, size_t size)
+	{
+		if( !buffer )
+			return;
+#if CARBON_MEMORY_POOL
+		const int c = ClassOf(size);
+		ChunkPool* pool = c >= 0 ? Local() : nullptr;
+		if( pool && pool->m_count[c] < pool->m_limit )
+		{
+			pool->m_free[c][pool->m_count[c]++] = buffer;
+			return;
+		}
+#endif
+		delete[] buffer;
+	}
+
+	// Lower the number of chunks retained per size class (clamped to CARBON_MEMORY_POOL_MAX_CHUNKS). Zero disables pooling on this thread.
+	void SetLimit(size_t chunksPerClass)
+	{
+		m_limit = Min(chunksPerClass, MaxRetained);
+		for( int c = 0; c != NumClasses; ++c )
+		{
+			while( m_count[c] > m_limit )
+				delete[] m_free[c][--m_count[c]];
+		}
+	}
+	size_t Limit() const { return m_limit; }
+
+	// Return every retained chunk to the heap
+	void Trim()
+	{
+		for( int c = 0; c != NumClasses; ++c )
+		{
+			while( m_count[c] )
+				delete[] m_free[c][--m_count[c]];
+		}
+	}
+
+	size_t RetainedChunks() const
+	{
+		size_t total = 0;
+		for( int c = 0; c != NumClasses; ++c )
+			total += m_count[c];
+		return total;
+	}
+	size_t RetainedBytes() const
+	{
+		size_t total = 0;
+		for( int c = 0; c != NumClasses; ++c )
+			total += m_count[c] * (MinChunkSize << c);
+		return total;
+	}
+
+  private:
+	ChunkPool(const ChunkPool&) = delete;
+	void operator=(const ChunkPool&) = delete;
+
+	static bool& TornDown()
+	{
+		thread_local bool tornDown = false;
+		return tornDown;
+	}
+	static int ClassOf(size_t size) // -1 if chunks of this size are never pooled
+	{
+		for( int c = 0; c != NumClasses; ++c )
+		{
+			if( size == (MinChunkSize << c) )
+				return c;
+		}
+		return -1;
+	}
+
+	uint8_t* m_free[NumClasses][MaxRetained] = {};
+	size_t m_count[NumClasses] = {};
+	size_t m_limit = MaxRetained;
+};
+
+// Position within an Allocator, see Allocator::Checkpoint
+struct AllocatorCheckpoint {
+	const void* chunk = nullptr;
+	size_t used = 0;
+	size_t requested = 0;
+	uint64_t epoch = 0;
+};
+
 // Simple arena implementation. A linked-list of large stacks of bytes
 class Allocator
 {
+	AllocTagStats* m_stats = nullptr;
+	size_t m_requested = 0; // bytes requested since the last clear, flushed into m_stats
+	uint64_t m_epoch = 0; // incremented by every clear, invalidating older checkpoints
 	CARBON_MEMORY_DBG(const char* tag = "?");
 
   public:
-	explicit Allocator(const char* tag = "?") CARBON_MEMORY_DBG( : tag(tag)) { Clear(); }
-	~Allocator() { Clear(); }
-	Allocator(Allocator&& o) CARBON_MEMORY_DBG( : tag(o.tag)), m_head(std::move(o.m_head)) {}
+	explicit Allocator(const char* tag = "?") CARBON_MEMORY_DBG( : tag(tag))
+	{
+#if CARBON_MEMORY_TELEMETRY
+		m_stats = &GetAllocTelemetry().Tag(tag);
+		m_stats->allocators.fetch_add(1, std::memory_order_relaxed);
+#endif
+		ClearChunks();
+	}
+	~Allocator()
+	{
+		if( m_head )
+		{
+			ClearChunks();
+			ReleaseChunkStats(*m_head);
+		}
+	}
+	Allocator(Allocator&& o) : m_stats(o.m_stats), m_requested(o.m_requested), m_epoch(o.m_epoch) CARBON_MEMORY_DBGC(tag(o.tag)), m_head(std::move(o.m_head))
+	{
+		o.m_requested = 0;
+		++o.m_epoch;
+	}
 	void Swap(Allocator& o)
 	{
 		m_head.swap(o.m_head);
+		std::swap(m_stats, o.m_stats);
+		std::swap(m_requested, o.m_requested);
+		std::swap(m_epoch, o.m_epoch);
 		CARBON_MEMORY_DBG(std::swap(tag, o.tag));
 	}
-	void Clear();
+	void Clear()
+	{
+		ClearChunks();
+		if( m_stats )
+			m_stats->clears.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Records the current allocation position. RewindTo releases everything allocated after this point, so a failed
+	// speculative parse can be discarded without clearing the whole arena. Clear() invalidates all checkpoints.
+	AllocatorCheckpoint Checkpoint() const
+	{
+		return { m_head.get(), m_head ? m_head->used : 0, m_requested, m_epoch };
+	}
+	void RewindTo(const AllocatorCheckpoint& checkpoint);
 
 	template<class T>
 	T* Alloc(ptrdiff_t count = 1)
@@ -262,6 +596,7 @@ class Allocator
 		if( !result )
 			result = Alloc<T>(NewChunk((carbon::size_t)(sizeof(T) * count)), (carbon::size_t)count);
 		CarbonAssert(result);
+		m_requested += sizeof(T) * (size_t)count;
 		return result;
 	}
 
@@ -273,6 +608,7 @@ class Allocator
 		if( !result.length )
 			result = Clone(NewChunk(input.length), input);
 		CarbonAssert(result.length);
+		m_requested += input.length;
 		return result;
 	}
 	inline char* Clone(const char* input)
@@ -301,6 +637,9 @@ class Allocator
 #if CARBON_MEMORY_CLEAR
 			if( a.get() )
 				memset(a.get(), 0xcd, size);
+#endif
+#if CARBON_MEMORY_BULK_ALLOCATION
+			ChunkPool::Release(a.release(), size);
 #endif
 			CARBON_MEMORY_DBG(LogFree(size, tag, this));
 		}
@@ -332,17 +671,36 @@ class Allocator
 #if !CARBON_MEMORY_BULK_ALLOCATION
 		size_t chunkSize = required;
 #else
-		size_t chunkSize = ((required + 65535) / 65536) * 65536; // round up to 64k chunk allocations
-		//size_t chunkSize = ((required+4095)/4096)*4096; // round up to 4k chunk allocations
+		size_t chunkSize = ChunkPool::RoundUp(required); // round up to 64k+ chunk allocations that can be recycled
 #endif
+#if !CARBON_MEMORY_BULK_ALLOCATION
 		uint8_t* buffer = new uint8_t[chunkSize];
+#else
+		uint8_t* buffer = ChunkPool::Acquire(chunkSize);
+#endif
 
 #if CARBON_MEMORY_CLEAR
 		memset(buffer, 0xff, chunkSize);
 #endif
 		m_head = std::make_unique<Chunk>(std::unique_ptr<uint8_t[]>(buffer), chunkSize, std::move(m_head) CARBON_MEMORY_DBGC(tag));
+		if( m_stats )
+		{
+			m_stats->chunksAllocated.fetch_add(1, std::memory_order_relaxed);
+			m_stats->chunksLive.fetch_add(1, std::memory_order_relaxed);
+			const uint64_t live = m_stats->chunkBytesLive.fetch_add(chunkSize, std::memory_order_relaxed) + chunkSize;
+			AllocTagStats::StoreMax(m_stats->chunkBytesPeak, live);
+		}
 		return *m_head;
 	}
+	void ReleaseChunkStats(const Chunk& chunk)
+	{
+		if( m_stats )
+		{
+			m_stats->chunksLive.fetch_sub(1, std::memory_order_relaxed);
+			m_stats->chunkBytesLive.fetch_sub(chunk.size, std::memory_order_relaxed);
+		}
+	}
+	void ClearChunks();
 
 	template<class T>
 	static T* Alloc(Chunk& chunk, size_t count = 1)
@@ -414,8 +772,63 @@ class Allocator
 	}
 };
 
-inline void Allocator::Clear()
+inline void Allocator::RewindTo(const AllocatorCheckpoint& checkpoint)
+{
+	CarbonAssert(checkpoint.epoch == m_epoch, "Allocator checkpoint is from before the last Clear");
+	CarbonAssert(checkpoint.chunk && checkpoint.requested <= m_requested);
+	while( m_head && m_head.get() != checkpoint.chunk )
+	{
+		ReleaseChunkStats(*m_head);
+		std::unique_ptr<Chunk> prev = std::move(m_head->prev);
+		m_head = std::move(prev);
+	}
+	CarbonAssert(m_head && checkpoint.used <= m_head->used, "Allocator checkpoint does not belong to this allocator");
+#if CARBON_MEMORY_CLEAR
+	memset(&m_head->a[checkpoint.used], 0xcc, m_head->used - checkpoint.used);
+#endif
+	m_head->used = checkpoint.used;
+	m_requested = checkpoint.requested;
+}
+
+// Rewinds an allocator to the point where the guard was created, unless Commit is called first. Covers both failure
+// returns and exceptions thrown by a parse in progress.
+class AllocatorRollback
+{
+	Allocator& m_alloc;
+	AllocatorCheckpoint m_checkpoint;
+	bool m_committed = false;
+
+  public:
+	explicit AllocatorRollback(Allocator& alloc) : m_alloc(alloc), m_checkpoint(alloc.Checkpoint()) {}
+	~AllocatorRollback()
+	{
+		if( !m_committed )
+			m_alloc.RewindTo(m_checkpoint);
+	}
+	AllocatorRollback(const AllocatorRollback&) = delete;
+	void operator=(const AllocatorRollback&) = delete;
+	void Commit() { m_committed = true; }
+};
+
+inline void Allocator::ClearChunks()
 {
+	if( m_stats && m_head )
+	{
+		size_t used = 0;
+		size_t slack = 0;
+		for( const Chunk* p = m_head.get(); p; p = p->prev.get() )
+		{
+			used += p->used;
+			slack += p->size - p->used;
+		}
+		CarbonAssert(used >= m_requested);
+		m_stats->bytesRequested.fetch_add(m_requested, std::memory_order_relaxed);
+		m_stats->bytesPadding.fetch_add(used - m_requested, std::memory_order_relaxed);
+		m_stats->bytesSlack.fetch_add(slack, std::memory_order_relaxed);
+		AllocTagStats::StoreMax(m_stats->arenaBytesPeak, used);
+	}
+	m_requested = 0;
+	++m_epoch;
 	Dbg_Nuke();
 	if( !m_head )
 		NewChunk(1);
@@ -428,6 +841,8 @@ inline void Allocator::Clear()
 		{
 			Chunk* prev = p->prev.get();
 			CarbonAssert(prev != m_head.get());
+			if( prev )
+				ReleaseChunkStats(*prev);
 			temp = std::move(p->prev);
 			p = prev;
 		}
@@ -534,39 +949,107 @@ ReadView ReadViewInPlace(const T& b, Allocator& a) { return { View(b), a, ReadVi
 template<class T>
 ReadView ReadViewCopy(const T& b, Allocator& a) { return { View(b), a, ReadView::Copy }; }
 
+// Serialization output. Appends to a Bytes buffer, fills a caller-provided fixed-size buffer, or, when
+// default-constructed, only counts the bytes that would have been written. Running a Write(...) call through a
+// counting view first gives the exact encoded size, so the real output buffer can be allocated once.
 class WriteView
 {
-	Bytes& m;
+	Bytes* m = nullptr; // append mode
+	uint8_t* m_fixed = nullptr; // fixed-buffer mode, when m_bounded is set
+	size_t m_size = 0; // bytes written in fixed-buffer and counting modes
+	size_t m_capacity = 0;
+	bool m_bounded = false;
+	bool m_overflow = false;
+	void (*m_sink)(void* context, const uint8_t* bytes, size_t length) = nullptr; // sink mode
+	void* m_sinkContext = nullptr;
+
+	bool Fits(size_t s)
+	{
+		if( s <= m_capacity - m_size )
+			return true;
+		m_overflow = true;
+		PHANTASMA_EXCEPTION("WriteView buffer overflow");
+		return false;
+	}
 
   public:
-	WriteView(Bytes& buf) : m(buf) {};
-	void WriteByte(uint8_t b) { m.push_back(b); }
+	WriteView() {}; // counting mode
+	WriteView(Bytes& buf) : m(&buf) {};
+	// A null buffer has no room, so the first write overflows
+	WriteView(uint8_t* buffer, size_t capacity) : m_fixed(buffer), m_capacity(buffer ? capacity : 0), m_bounded(true) {};
+	// Hands every write to Output::Sink (see SHA256Hasher) and keeps only the count, like counting mode
+	template<class Output>
+	static WriteView ToSink(Output& output)
+	{
+		WriteView w;
+		w.m_sink = &Output::Sink;
+		w.m_sinkContext = &output;
+		return w;
+	}
+	void WriteByte(uint8_t b)
+	{
+		if( m )
+		{
+			m->push_back(b);
+			return;
+		}
+		if( m_sink )
+			m_sink(m_sinkContext, &b, 1);
+		if( m_bounded )
+		{
+			if( !Fits(1) )
+				return;
+			m_fixed[m_size] = b;
+		}
+		++m_size;
+	}
 	void WriteBytes(ByteView b) { WriteBytes(b.bytes, b.length); }
 	void WriteBytes(const uint8_t* b, size_t s)
 	{
 		if( !s )
 			return;
-		size_t offset = m.size();
-		m.resize(offset + s);
-		memcpy(&m.front() + offset, b, s);
+		if( m )
+		{
+			size_t offset = m->size();
+			m->resize(offset + s);
+			memcpy(&m->front() + offset, b, s);
+			return;
+		}
+		if( m_bounded )
+		{
+			if( !Fits(s) )
+				return;
+			memcpy(m_fixed + m_size, b, s);
+		}
+		else if( m_sink )
+			m_sink(m_sinkContext, b, s);
+		m_size += s;
+	}
+	void Reserve(size_t s)
+	{
+		if( m )
+			m->reserve(m->size() + s);
 	}
-	void Reserve(size_t s) { m.reserve(m.size() + s); }
 
-	const void* Mark() const { return (void*)(intptr_t)m.size(); } // return handle of where the write cursor is up to
+	size_t Size() const { return m ? m->size() : m_size; } // number of bytes written (or counted) so far
+	bool Counting() const { return !m && !m_bounded && !m_sink; }
+	bool Overflow() const { return m_overflow; } // a fixed-buffer write was truncated
+
+	const void* Mark() const { return (void*)(intptr_t)Size(); } // return handle of where the write cursor is up to
 
-	// Views are invalidated on next write operation!
-	ByteView View() const { return carbon::View(m); } // view of everything written
+	// Views are invalidated on next write operation! Counting views have no bytes to look at.
+	ByteView View() const { return m ? carbon::View(*m) : ByteView{ m_fixed, m_fixed ? m_size : 0 }; } // view of everything written
 	ByteView View(const void* marker) const // view from previous mark call to now
 	{
-		ByteView v = carbon::View(m);
+		ByteView v = View();
 		auto begin = (size_t)(intptr_t)marker;
-		auto end = m.size();
+		auto end = v.length;
 		CarbonAssert(end >= begin);
 		return { v.bytes + begin, end - begin };
 	}
 	ByteView View(const void* markerBegin, const void* markerEnd) const // view between two previous mark calls
 	{
-		ByteView v = carbon::View(m);
+		ByteView v = View();
 		auto begin = (size_t)(intptr_t)markerBegin;
 		auto end = (size_t)(intptr_t)markerEnd;
 		CarbonAssert(end >= begin);
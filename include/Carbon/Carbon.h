@@ -327,11 +327,19 @@ inline std::vector<int8_t> ReadArray8(ReadView& r)
 //------------------------------------------------------------------------------
 // Serialization entry points
 //------------------------------------------------------------------------------
+template<class T>
+size_t CarbonSerializedSize(const T& blob)
+{
+	WriteView w;
+	Write(blob, w);
+	return w.Size();
+}
+
 template<class T>
 ByteArray CarbonSerialize(const T& blob)
 {
-	ByteArray buffer;
-	WriteView w(buffer);
+	ByteArray buffer(CarbonSerializedSize(blob));
+	WriteView w(buffer.empty() ? nullptr : &buffer.front(), buffer.size());
 	Write(blob, w);
 	return buffer;
 }
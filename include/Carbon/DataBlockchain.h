@@ -260,6 +260,20 @@ inline void Write(const Witnesses& in, WriteView& w)
 	}
 }
 
+inline bool Read(Witness& out, ReadView& reader)
+{
+	return Read(out.address, reader) && Read(out.signature, reader);
+}
+
+inline bool Read(Witnesses& out, ReadView& reader, Allocator& alloc)
+{
+	Witness* items = nullptr;
+	const bool ok = ReadArray(out.numWitnesses, items, reader, alloc, [](Witness& witness, ReadView& r)
+	    { return Read(witness, r); }, Bytes32::length + Bytes64::length);
+	out.witnesses = items;
+	return ok;
+}
+
 // Primitive serialization -----------------------------------------------------
 inline void Write(const ChainConfig& in, WriteView& w)
 {
@@ -318,20 +332,29 @@ inline bool Read(MsgCallArgSections& out, ReadView& reader, Allocator& alloc)
 		return false;
 	}
 	out.numArgSections_negative = count;
-	const uint32_t length = (uint32_t)(-count);
+	// Negated in unsigned arithmetic, as -INT32_MIN does not fit an int32_t
+	const uint32_t length = 0u - (uint32_t)count;
 	if( length == 0 )
 	{
 		out.argSections = nullptr;
 		return true;
 	}
-	out.argSections = alloc.Alloc<MsgCallArgs>(length);
+	// Every section starts with a 4 byte length or register offset
+	if( !CountFits(length, reader, 4) )
+	{
+		out.argSections = nullptr;
+		return false;
+	}
+	AllocatorRollback rollback(alloc);
+	MsgCallArgs* sections = alloc.Alloc<MsgCallArgs>(length);
+	out.argSections = nullptr;
 	for( uint32_t i = 0; i != length; ++i )
 	{
-		if( !Read(out.argSections[i], reader, alloc) )
-		{
+		if( !Read(sections[i], reader, alloc) || reader.Failure() )
 			return false;
-		}
 	}
+	rollback.Commit();
+	out.argSections = sections;
 	return true;
 }
 
@@ -413,6 +436,101 @@ inline void Write(const TxMsgSpecialResolution& in, WriteView& w)
 	Write(in.calls, w);
 }
 
+inline bool Read(TxMsgTransferFungible& out, ReadView& reader)
+{
+	return Read(out.to, reader) && Read(out.tokenId, reader) && Read(out.amount, reader);
+}
+
+inline bool Read(TxMsgTransferFungible_GasPayer& out, ReadView& reader)
+{
+	return Read(out.to, reader) && Read(out.from, reader) && Read(out.tokenId, reader) && Read(out.amount, reader);
+}
+
+inline bool Read(TxMsgTransferNonFungible_Single& out, ReadView& reader)
+{
+	return Read(out.to, reader) && Read(out.tokenId, reader) && Read(out.instanceId, reader);
+}
+
+inline bool Read(TxMsgTransferNonFungible_Single_GasPayer& out, ReadView& reader)
+{
+	return Read(out.to, reader) && Read(out.from, reader) && Read(out.tokenId, reader) && Read(out.instanceId, reader);
+}
+
+inline bool ReadInstanceIds(uint32_t& count, const uint64_t*& instanceIds, ReadView& reader, Allocator& alloc)
+{
+	uint64_t* items = nullptr;
+	const bool ok = ReadArray(count, items, reader, alloc, [](uint64_t& id, ReadView& r)
+	    { return Read(id, r); }, sizeof(uint64_t));
+	instanceIds = items;
+	return ok;
+}
+
+inline bool Read(TxMsgTransferNonFungible_Multi& out, ReadView& reader, Allocator& alloc)
+{
+	return Read(out.to, reader) && Read(out.tokenId, reader) && ReadInstanceIds(out.numInstanceIds, out.instanceIds, reader, alloc);
+}
+
+inline bool Read(TxMsgTransferNonFungible_Multi_GasPayer& out, ReadView& reader, Allocator& alloc)
+{
+	return Read(out.to, reader) && Read(out.from, reader) && Read(out.tokenId, reader) && ReadInstanceIds(out.numInstanceIds, out.instanceIds, reader, alloc);
+}
+
+inline bool Read(TxMsgMintFungible& out, ReadView& reader)
+{
+	return Read(out.tokenId, reader) && Read(out.to, reader) && Read(out.amount.x(), reader);
+}
+
+inline bool Read(TxMsgBurnFungible& out, ReadView& reader)
+{
+	return Read(out.tokenId, reader) && Read(out.amount.x(), reader);
+}
+
+inline bool Read(TxMsgBurnFungible_GasPayer& out, ReadView& reader)
+{
+	return Read(out.tokenId, reader) && Read(out.from, reader) && Read(out.amount.x(), reader);
+}
+
+inline bool Read(TxMsgMintNonFungible& out, ReadView& reader, Allocator& alloc)
+{
+	return Read(out.tokenId, reader) && Read(out.to, reader) && Read(out.seriesId, reader) && ReadArray(out.rom, reader, alloc) && ReadArray(out.ram, reader, alloc);
+}
+
+inline bool Read(TxMsgBurnNonFungible& out, ReadView& reader)
+{
+	return Read(out.tokenId, reader) && Read(out.instanceId, reader);
+}
+
+inline bool Read(TxMsgBurnNonFungible_GasPayer& out, ReadView& reader)
+{
+	return Read(out.tokenId, reader) && Read(out.from, reader) && Read(out.instanceId, reader);
+}
+
+inline bool Read(TxMsgTrade& out, ReadView& reader, Allocator& alloc)
+{
+	return ReadArray(out.numTransferF, out.transferF, reader, alloc, [](TxMsgTransferFungible_GasPayer& i, ReadView& r)
+	           { return Read(i, r); }) &&
+	       ReadArray(out.numTransferN, out.transferN, reader, alloc, [](TxMsgTransferNonFungible_Single_GasPayer& i, ReadView& r)
+	           { return Read(i, r); }) &&
+	       ReadArray(out.numMintF, out.mintF, reader, alloc, [](TxMsgMintFungible& i, ReadView& r)
+	           { return Read(i, r); }) &&
+	       ReadArray(out.numBurnF, out.burnF, reader, alloc, [](TxMsgBurnFungible_GasPayer& i, ReadView& r)
+	           { return Read(i, r); }) &&
+	       ReadArray(out.numMintN, out.mintN, reader, alloc, [&](TxMsgMintNonFungible& i, ReadView& r)
+	           { return Read(i, r, alloc); }) &&
+	       ReadArray(out.numBurnN, out.burnN, reader, alloc, [](TxMsgBurnNonFungible_GasPayer& i, ReadView& r)
+	           { return Read(i, r); });
+}
+
+inline bool Read(TxMsgPhantasma& out, ReadView& reader, Allocator& alloc)
+{
+	return Read(out.nexus, reader) && Read(out.chain, reader) && ReadArray(out.script, reader, alloc);
+}
+
+inline bool Read(TxMsgPhantasma_Raw& out, ReadView& reader, Allocator& alloc)
+{
+	return ReadArray(out.transaction, reader, alloc);
+}
+
 inline void Write(const TxMsgTransferFungible& in, WriteView& w)
 {
 	Write(in.to, w);
@@ -491,8 +609,8 @@ inline void Write(const TxMsgMintNonFungible& in, WriteView& w)
 	Write8u(in.tokenId, w);
 	Write(in.to, w);
 	Write4((int32_t)in.seriesId, w);
-	WriteArray(ByteArray(in.rom.bytes, in.rom.bytes + in.rom.length), w);
-	WriteArray(ByteArray(in.ram.bytes, in.ram.bytes + in.ram.length), w);
+	WriteArray(in.rom, w);
+	WriteArray(in.ram, w);
 }
 
 inline void Write(const TxMsgBurnNonFungible& in, WriteView& w)
@@ -534,12 +652,12 @@ inline void Write(const TxMsgPhantasma& in, WriteView& w)
 {
 	Write(in.nexus, w);
 	Write(in.chain, w);
-	WriteArray(ByteArray(in.script.bytes, in.script.bytes + in.script.length), w);
+	WriteArray(in.script, w);
 }
 
 inline void Write(const TxMsgPhantasma_Raw& in, WriteView& w)
 {
-	WriteArray(ByteArray(in.transaction.bytes, in.transaction.bytes + in.transaction.length), w);
+	WriteArray(in.transaction, w);
 }
 
 inline void Write(const TxMsg& msg, WriteView& w)
@@ -610,14 +728,124 @@ inline void Write(const TxMsg& msg, WriteView& w)
 	}
 }
 
+// Byte payloads (call args, ROM/RAM, scripts) point into the source buffer when the reader allows InPlace reads,
+// and are copied into alloc otherwise.
+inline bool Read(TxMsg& out, ReadView& reader, Allocator& alloc)
+{
+	out.type = (TxTypes)Read1(reader);
+	out.expiry = Read8(reader);
+	out.maxGas = Read8u(reader);
+	out.maxData = Read8u(reader);
+	if( !Read(out.gasFrom, reader) || !Read(out.payload, reader) )
+	{
+		return false;
+	}
+
+	bool ok = false;
+	switch( out.type )
+	{
+	case TxTypes::Call:
+		out.call = {};
+		ok = Read(out.call, reader, alloc);
+		break;
+	case TxTypes::Call_Multi:
+		out.callMulti = {};
+		ok = Read(out.callMulti, reader, alloc);
+		break;
+	case TxTypes::Trade:
+		out.trade = {};
+		ok = Read(out.trade, reader, alloc);
+		break;
+	case TxTypes::TransferFungible:
+		out.transferFt = {};
+		ok = Read(out.transferFt, reader);
+		break;
+	case TxTypes::TransferFungible_GasPayer:
+		out.transferFtGasPayer = {};
+		ok = Read(out.transferFtGasPayer, reader);
+		break;
+	case TxTypes::TransferNonFungible_Single:
+		out.transferNftSingle = {};
+		ok = Read(out.transferNftSingle, reader);
+		break;
+	case TxTypes::TransferNonFungible_Single_GasPayer:
+		out.transferNftSingleGasPayer = {};
+		ok = Read(out.transferNftSingleGasPayer, reader);
+		break;
+	case TxTypes::TransferNonFungible_Multi:
+		out.transferNftMulti = {};
+		ok = Read(out.transferNftMulti, reader, alloc);
+		break;
+	case TxTypes::TransferNonFungible_Multi_GasPayer:
+		out.transferNftMultiGasPayer = {};
+		ok = Read(out.transferNftMultiGasPayer, reader, alloc);
+		break;
+	case TxTypes::MintFungible:
+		out.mintFungible = {};
+		ok = Read(out.mintFungible, reader);
+		break;
+	case TxTypes::BurnFungible:
+		out.burnFungible = {};
+		ok = Read(out.burnFungible, reader);
+		break;
+	case TxTypes::BurnFungible_GasPayer:
+		out.burnFungibleGasPayer = {};
+		ok = Read(out.burnFungibleGasPayer, reader);
+		break;
+	case TxTypes::MintNonFungible:
+		out.mintNonFungible = {};
+		ok = Read(out.mintNonFungible, reader, alloc);
+		break;
+	case TxTypes::BurnNonFungible:
+		out.burnNonFungible = {};
+		ok = Read(out.burnNonFungible, reader);
+		break;
+	case TxTypes::BurnNonFungible_GasPayer:
+		out.burnNonFungibleGasPayer = {};
+		ok = Read(out.burnNonFungibleGasPayer, reader);
+		break;
+	case TxTypes::Phantasma:
+		out.phantasma = {};
+		ok = Read(out.phantasma, reader, alloc);
+		break;
+	case TxTypes::Phantasma_Raw:
+		out.phantasmaRaw = {};
+		ok = Read(out.phantasmaRaw, reader, alloc);
+		break;
+	default:
+		return false;
+	}
+	return ok && !reader.Failure();
+}
+
 struct SignedTxMsg {
 	TxMsg msg;
 	Witnesses witnesses{};
 };
 
-inline void Write(const SignedTxMsg& signedMsg, WriteView& w)
+// The second signer of the *_GasPayer message types, or null for types that are not co-signed
+inline const Bytes32* GasPayerSender(const TxMsg& msg)
+{
+	switch( msg.type )
+	{
+	case TxTypes::TransferFungible_GasPayer:
+		return &msg.transferFtGasPayer.from;
+	case TxTypes::TransferNonFungible_Single_GasPayer:
+		return &msg.transferNftSingleGasPayer.from;
+	case TxTypes::TransferNonFungible_Multi_GasPayer:
+		return &msg.transferNftMultiGasPayer.from;
+	case TxTypes::BurnFungible_GasPayer:
+		return &msg.burnFungibleGasPayer.from;
+	case TxTypes::BurnNonFungible_GasPayer:
+		return &msg.burnNonFungibleGasPayer.from;
+	default:
+		return nullptr;
+	}
+}
+
+// The witness section that follows the message in a signed transaction
+inline void WriteWitnesses(const SignedTxMsg& signedMsg, WriteView& w)
 {
-	Write(signedMsg.msg, w);
 	const TxTypes type = signedMsg.msg.type;
 	const Witnesses& witnessList = signedMsg.witnesses;
 
@@ -639,27 +867,7 @@ inline void Write(const SignedTxMsg& signedMsg, WriteView& w)
 	case TxTypes::TransferNonFungible_Multi_GasPayer:
 	case TxTypes::BurnFungible_GasPayer:
 	case TxTypes::BurnNonFungible_GasPayer: {
-		Bytes32 from;
-		switch( type )
-		{
-		case TxTypes::TransferFungible_GasPayer:
-			from = signedMsg.msg.transferFtGasPayer.from;
-			break;
-		case TxTypes::TransferNonFungible_Single_GasPayer:
-			from = signedMsg.msg.transferNftSingleGasPayer.from;
-			break;
-		case TxTypes::TransferNonFungible_Multi_GasPayer:
-			from = signedMsg.msg.transferNftMultiGasPayer.from;
-			break;
-		case TxTypes::BurnFungible_GasPayer:
-			from = signedMsg.msg.burnFungibleGasPayer.from;
-			break;
-		case TxTypes::BurnNonFungible_GasPayer:
-			from = signedMsg.msg.burnNonFungibleGasPayer.from;
-			break;
-		default:
-			break;
-		}
+		const Bytes32& from = *GasPayerSender(signedMsg.msg);
 		Throw::Assert(witnessList.numWitnesses == 2 &&
 		                  witnessList.witnesses &&
 		                  witnessList.witnesses[0].address == signedMsg.msg.gasFrom &&
@@ -692,31 +900,93 @@ inline void Write(const SignedTxMsg& signedMsg, WriteView& w)
 	}
 }
 
+inline void Write(const SignedTxMsg& signedMsg, WriteView& w)
+{
+	Write(signedMsg.msg, w);
+	WriteWitnesses(signedMsg, w);
+}
+
+// Inverse of WriteWitnesses. Types with implied signers only carry signatures on the wire, so their witness
+// addresses are restored from the message.
+inline bool ReadWitnesses(SignedTxMsg& out, ReadView& reader, Allocator& alloc)
+{
+	const TxMsg& msg = out.msg;
+	switch( msg.type )
+	{
+	case TxTypes::TransferFungible:
+	case TxTypes::TransferNonFungible_Single:
+	case TxTypes::TransferNonFungible_Multi:
+	case TxTypes::MintFungible:
+	case TxTypes::BurnFungible:
+	case TxTypes::MintNonFungible:
+	case TxTypes::BurnNonFungible: {
+		Witness* witness = alloc.Alloc<Witness>(1);
+		witness->address = msg.gasFrom;
+		out.witnesses = Witnesses{ 1, witness };
+		return Read(witness->signature, reader);
+	}
+
+	case TxTypes::TransferFungible_GasPayer:
+	case TxTypes::TransferNonFungible_Single_GasPayer:
+	case TxTypes::TransferNonFungible_Multi_GasPayer:
+	case TxTypes::BurnFungible_GasPayer:
+	case TxTypes::BurnNonFungible_GasPayer: {
+		Witness* witnesses = alloc.Alloc<Witness>(2);
+		witnesses[0].address = msg.gasFrom;
+		witnesses[1].address = *GasPayerSender(msg);
+		out.witnesses = Witnesses{ 2, witnesses };
+		return Read(witnesses[0].signature, reader) && Read(witnesses[1].signature, reader);
+	}
+
+	case TxTypes::Call:
+	case TxTypes::Call_Multi:
+	case TxTypes::Trade:
+	case TxTypes::Phantasma:
+		return Read(out.witnesses, reader, alloc);
+
+	case TxTypes::Phantasma_Raw:
+		out.witnesses = {};
+		return true;
+
+	default:
+		return false;
+	}
+}
+
+inline bool Read(SignedTxMsg& out, ReadView& reader, Allocator& alloc)
+{
+	out.witnesses = {};
+	return Read(out.msg, reader, alloc) && ReadWitnesses(out, reader, alloc) && !reader.Failure();
+}
+
 // Helpers --------------------------------------------------------------------
 inline ByteArray SerializeTx(const TxMsg& msg)
 {
-	ByteArray buffer;
-	WriteView w(buffer);
-	Write(msg, w);
-	return buffer;
+	return CarbonSerialize(msg);
 }
 
 struct TxMsgSigner {
+	// The signed encoding starts with the unsigned message, so the message is written once into an exactly-sized
+	// buffer, signed in place, and followed by the witness section.
 	static ByteArray SignAndSerialize(const TxMsg& msg, const PhantasmaKeys& keys)
 	{
-		const ByteArray serializedMsg = SerializeTx(msg);
-		const Ed25519Signature sig = Ed25519Signature::Generate(keys, serializedMsg);
-		Bytes64 sigBytes(sig.Bytes(), Ed25519Signature::Length);
-
-		Witness witness{ Bytes32(keys.GetPublicKey()), sigBytes };
+		Witness witness{ Bytes32(keys.GetPublicKey()), Bytes64{} };
 
 		SignedTxMsg signedMsg;
 		signedMsg.msg = msg;
 		signedMsg.witnesses = Witnesses{ 1, &witness };
 
-		ByteArray buffer;
-		WriteView w(buffer);
-		Write(signedMsg, w);
+		WriteView counter;
+		Write(msg, counter);
+		const size_t msgLength = counter.Size();
+		WriteWitnesses(signedMsg, counter);
+
+		ByteArray buffer(counter.Size());
+		WriteView w(&buffer.front(), buffer.size());
+		Write(msg, w);
+		const Ed25519Signature sig = Ed25519Signature::Generate(keys, &buffer.front(), (int)msgLength);
+		witness.signature = Bytes64(sig.Bytes(), Ed25519Signature::Length);
+		WriteWitnesses(signedMsg, w);
 		return buffer;
 	}
 };
@@ -404,6 +404,14 @@ inline void WriteArray(uint32_t length, const Bytes64* items, WriteView& writer)
 		WriteExactly((const Byte*)items[i].bytes, Bytes64::length, writer);
 }
 
+// Whether the rest of the input can hold count elements of at least minElementSize bytes each. Counts come from the
+// input, so this is checked before allocating; otherwise a few bytes could claim billions of elements. Elements that
+// may encode to nothing are still held to one per remaining byte, as such arrays carry no information.
+inline bool CountFits(uint32_t count, const ReadView& reader, size_t minElementSize = 1)
+{
+	return count <= reader.length / PHANTASMA_MAX(minElementSize, (size_t)1);
+}
+
 inline bool ReadArray(ByteView& out, ReadView& reader, Allocator& alloc)
 {
 	const int32_t len = Read4(reader);
@@ -416,9 +424,9 @@ inline bool ReadArray(ByteView& out, ReadView& reader, Allocator& alloc)
 		out = {};
 		return true;
 	}
-	ByteArray bytes = ReadExactly((size_t)len, reader);
-	Byte* storage = alloc.Clone(bytes.data(), bytes.size());
-	out = ByteView{ storage, bytes.size() };
+	ByteView source;
+	Throw::If(!reader.Advance((size_t)len, source), "end of stream reached");
+	out = reader.AllowInPlace() ? source : alloc.Clone(source);
 	return true;
 }
 
@@ -435,6 +443,10 @@ inline bool ReadArray(uint32_t& length, ByteView*& items, ReadView& reader, Allo
 		items = nullptr;
 		return true;
 	}
+	if( !CountFits(length, reader, 4) )
+	{
+		return false;
+	}
 	ByteView* arr = alloc.Alloc<ByteView>(length);
 	items = arr;
 	for( uint32_t i = 0; i != length; ++i )
@@ -447,8 +459,9 @@ inline bool ReadArray(uint32_t& length, ByteView*& items, ReadView& reader, Allo
 	return true;
 }
 
+// minElementSize is the fewest bytes fn consumes for one element
 template<class T, class ReaderFunc>
-inline bool ReadArray(uint32_t& length, T*& items, ReadView& reader, Allocator& alloc, ReaderFunc fn)
+inline bool ReadArray(uint32_t& length, T*& items, ReadView& reader, Allocator& alloc, ReaderFunc fn, size_t minElementSize = 1)
 {
 	const int32_t len = Read4(reader);
 	if( len < 0 )
@@ -461,6 +474,10 @@ inline bool ReadArray(uint32_t& length, T*& items, ReadView& reader, Allocator&
 		items = nullptr;
 		return true;
 	}
+	if( !CountFits(length, reader, minElementSize) )
+	{
+		return false;
+	}
 	T* arr = alloc.Alloc<T>(length);
 	items = arr;
 	for( uint32_t i = 0; i != length; ++i )
@@ -496,6 +513,10 @@ inline bool ReadArraySz(uint32_t& length, const char**& items, ReadView& reader,
 		items = nullptr;
 		return true;
 	}
+	if( !CountFits(length, reader) )
+	{
+		return false;
+	}
 	const char** arr = alloc.Alloc<const char*>(length);
 	items = arr;
 	for( uint32_t i = 0; i != length; ++i )
@@ -530,6 +551,10 @@ inline bool Read(VmStructSchema& out, ReadView& reader, Allocator& alloc)
 		return false;
 	}
 	out.numFields = (uint32_t)len;
+	if( !CountFits(out.numFields, reader, 2) )
+	{
+		return false;
+	}
 	out.fields = out.numFields ? alloc.Alloc<VmNamedVariableSchema>(out.numFields) : nullptr;
 	for( uint32_t i = 0; i != out.numFields; ++i )
 	{
@@ -595,6 +620,10 @@ inline bool Read(VmDynamicStruct& out, ReadView& reader, Allocator& alloc)
 		return false;
 	}
 	out.numFields = (uint32_t)len;
+	if( !CountFits(out.numFields, reader, 2) )
+	{
+		return false;
+	}
 	out.fields = out.numFields ? alloc.Alloc<VmNamedDynamicVariable>(out.numFields) : nullptr;
 	for( uint32_t i = 0; i != out.numFields; ++i )
 	{
@@ -1019,6 +1048,10 @@ inline bool Read(VmType type, VmDynamicVariable& out, const VmStructSchema* sche
 			}
 			schemaPtr = &readSchema;
 		}
+		if( !CountFits(out.arrayLength, reader) )
+		{
+			return false;
+		}
 		VmDynamicStruct* structs = alloc.Alloc<VmDynamicStruct>(out.arrayLength);
 		out.data.structureArray.schema = schemaPtr ? *schemaPtr : VmStructSchema{};
 		out.data.structureArray.structs = structs;
@@ -1043,25 +1076,25 @@ inline bool Read(VmType type, VmDynamicVariable& out, const VmStructSchema* sche
 		    { v = Read1(r); return true; });
 	case(uint8_t)VmType::Int16:
 		return ReadArray(out.arrayLength, out.data.int16Array, reader, alloc, [](uint16_t& v, ReadView& r)
-		    { v = (uint16_t)Read2(r); return true; });
+		    { v = (uint16_t)Read2(r); return true; }, 2);
 	case(uint8_t)VmType::Int32:
 		return ReadArray(out.arrayLength, out.data.int32Array, reader, alloc, [](uint32_t& v, ReadView& r)
-		    { v = (uint32_t)Read4(r); return true; });
+		    { v = (uint32_t)Read4(r); return true; }, 4);
 	case(uint8_t)VmType::Int64:
 		return ReadArray(out.arrayLength, out.data.int64Array, reader, alloc, [](uint64_t& v, ReadView& r)
-		    { v = Read8u(r); return true; });
+		    { v = Read8u(r); return true; }, 8);
 	case(uint8_t)VmType::Int256:
 		return ReadArray(out.arrayLength, out.data.int256Array, reader, alloc, [](uint256& v, ReadView& r)
 		    { int256 temp; bool ok = Read(temp, r); v = temp.Unsigned(); return ok; });
 	case(uint8_t)VmType::Bytes16:
 		return ReadArray(out.arrayLength, out.data.bytes16Array, reader, alloc, [](Bytes16& v, ReadView& r)
-		    { return r.ReadBytes(v.bytes, Bytes16::length); });
+		    { return r.ReadBytes(v.bytes, Bytes16::length); }, Bytes16::length);
 	case(uint8_t)VmType::Bytes32:
 		return ReadArray(out.arrayLength, out.data.bytes32Array, reader, alloc, [](Bytes32& v, ReadView& r)
-		    { return r.ReadBytes(v.bytes, Bytes32::length); });
+		    { return r.ReadBytes(v.bytes, Bytes32::length); }, Bytes32::length);
 	case(uint8_t)VmType::Bytes64:
 		return ReadArray(out.arrayLength, out.data.bytes64Array, reader, alloc, [](Bytes64& v, ReadView& r)
-		    { return r.ReadBytes(v.bytes, Bytes64::length); });
+		    { return r.ReadBytes(v.bytes, Bytes64::length); }, Bytes64::length);
 	case(uint8_t)VmType::String:
 		return ReadArraySz(out.arrayLength, out.data.stringArray, reader, alloc);
 	default:
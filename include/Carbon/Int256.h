@@ -8,6 +8,12 @@
 #include <cstring>
 #include <string>
 
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#elif defined(__x86_64__)
+#include <x86intrin.h>
+#endif
+
 #include "DataCommon.h"
 
 namespace phantasma::carbon {
@@ -26,12 +32,194 @@ void Write(const uint256& in, WriteView& writer);
 void Write(const int256& in, WriteView& writer);
 void Write(const intx& in, WriteView& writer);
 
+// Selects between the constexpr-friendly code path and intrinsics at run time
+#if defined(__has_builtin)
+#if __has_builtin(__builtin_is_constant_evaluated)
+#define CARBON_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#endif
+#if !defined(CARBON_CONSTANT_EVALUATED) && defined(_MSC_VER) && _MSC_VER >= 1925
+#define CARBON_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+#if !defined(CARBON_CONSTANT_EVALUATED)
+#define CARBON_CONSTANT_EVALUATED() true // no way to tell, so always take the portable path
+#endif
+
+//------------------------------------------------------------------------------
+// 4x64-bit limb kernels. All arithmetic wraps modulo 2^256, matching the validator runtime.
+namespace Int256Limbs {
+
+constexpr int Count = 4;
+
+constexpr uint64_t AddCarry(uint64_t a, uint64_t b, uint8_t& carry)
+{
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__x86_64__)
+	if( !CARBON_CONSTANT_EVALUATED() )
+	{
+		unsigned long long out = 0;
+		carry = _addcarry_u64(carry, a, b, &out);
+		return out;
+	}
+#endif
+	uint64_t sum = a + b;
+	uint8_t c = sum < a;
+	uint64_t out = sum + carry;
+	carry = c | (out < sum);
+	return out;
+}
+constexpr uint64_t SubBorrow(uint64_t a, uint64_t b, uint8_t& borrow)
+{
+#if (defined(_MSC_VER) && defined(_M_X64)) || defined(__x86_64__)
+	if( !CARBON_CONSTANT_EVALUATED() )
+	{
+		unsigned long long out = 0;
+		borrow = _subborrow_u64(borrow, a, b, &out);
+		return out;
+	}
+#endif
+	uint64_t diff = a - b;
+	uint8_t c = a < b;
+	uint64_t out = diff - borrow;
+	borrow = c | (diff < borrow);
+	return out;
+}
+// Full 64x64 -> 128-bit product
+constexpr uint64_t Mul(uint64_t a, uint64_t b, uint64_t& hi)
+{
+#if defined(__SIZEOF_INT128__)
+	unsigned __int128 p = (unsigned __int128)a * b;
+	hi = (uint64_t)(p >> 64);
+	return (uint64_t)p;
+#else
+#if defined(_MSC_VER) && defined(_M_X64)
+	if( !CARBON_CONSTANT_EVALUATED() )
+	{
+		unsigned long long h = 0;
+		uint64_t lo = _umul128(a, b, &h);
+		hi = h;
+		return lo;
+	}
+#endif
+	uint64_t aLo = (uint32_t)a, aHi = a >> 32, bLo = (uint32_t)b, bHi = b >> 32;
+	uint64_t ll = aLo * bLo, lh = aLo * bHi, hl = aHi * bLo, hh = aHi * bHi;
+	uint64_t mid = (ll >> 32) + (uint32_t)lh + (uint32_t)hl;
+	hi = hh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+	return (mid << 32) | (uint32_t)ll;
+#endif
+}
+constexpr void Copy(const uint64_t* a, uint64_t* r)
+{
+	for( int i = 0; i != Count; ++i )
+		r[i] = a[i];
+}
+constexpr bool IsZero(const uint64_t* a)
+{
+	return !(a[0] | a[1] | a[2] | a[3]);
+}
+constexpr int Compare(const uint64_t* a, const uint64_t* b)
+{
+	for( int i = Count; i-- > 0; )
+	{
+		if( a[i] != b[i] )
+			return a[i] > b[i] ? 1 : -1;
+	}
+	return 0;
+}
+constexpr void Add(const uint64_t* a, const uint64_t* b, uint64_t* r)
+{
+	uint8_t carry = 0;
+	r[0] = AddCarry(a[0], b[0], carry);
+	r[1] = AddCarry(a[1], b[1], carry);
+	r[2] = AddCarry(a[2], b[2], carry);
+	r[3] = AddCarry(a[3], b[3], carry);
+}
+constexpr void Sub(const uint64_t* a, const uint64_t* b, uint64_t* r)
+{
+	uint8_t borrow = 0;
+	r[0] = SubBorrow(a[0], b[0], borrow);
+	r[1] = SubBorrow(a[1], b[1], borrow);
+	r[2] = SubBorrow(a[2], b[2], borrow);
+	r[3] = SubBorrow(a[3], b[3], borrow);
+}
+constexpr void Increment(uint64_t* a)
+{
+	for( int i = 0; i != Count && !++a[i]; ++i )
+	{
+	}
+}
+constexpr void Decrement(uint64_t* a)
+{
+	for( int i = 0; i != Count && !a[i]--; ++i )
+	{
+	}
+}
+constexpr void Negate(const uint64_t* a, uint64_t* r)
+{
+	const uint64_t zero[Count] = {};
+	Sub(zero, a, r);
+}
+// Low 256 bits of a*b. r may alias a or b.
+constexpr void Mul(const uint64_t* a, const uint64_t* b, uint64_t* r)
+{
+	uint64_t t[Count] = {};
+	for( int i = 0; i != Count; ++i )
+	{
+		if( !a[i] )
+			continue;
+		uint64_t carry = 0;
+		for( int j = 0; i + j != Count; ++j )
+		{
+			uint64_t hi = 0;
+			uint64_t lo = Mul(a[i], b[j], hi);
+			uint8_t c = 0;
+			lo = AddCarry(lo, carry, c);
+			hi += c;
+			c = 0;
+			t[i + j] = AddCarry(t[i + j], lo, c);
+			carry = hi + c;
+		}
+	}
+	Copy(t, r);
+}
+constexpr void ShiftLeft(const uint64_t* a, uint64_t* r, int nbits)
+{
+	CarbonAssert(nbits >= 0, "no negative shifts");
+	uint64_t t[Count] = {};
+	const int nwords = nbits / 64;
+	const int shift = nbits % 64;
+	for( int i = Count; i-- > nwords; )
+	{
+		t[i] = a[i - nwords] << shift;
+		if( shift && i - nwords > 0 )
+			t[i] |= a[i - nwords - 1] >> (64 - shift);
+	}
+	Copy(t, r);
+}
+constexpr void ShiftRight(const uint64_t* a, uint64_t* r, int nbits)
+{
+	CarbonAssert(nbits >= 0, "no negative shifts");
+	uint64_t t[Count] = {};
+	const int nwords = nbits / 64;
+	const int shift = nbits % 64;
+	for( int i = 0; i + nwords < Count; ++i )
+	{
+		t[i] = a[i + nwords] >> shift;
+		if( shift && i + nwords + 1 < Count )
+			t[i] |= a[i + nwords + 1] << (64 - shift);
+	}
+	Copy(t, r);
+}
+
+} // namespace Int256Limbs
+
+// Construction, add, sub, mul, shifts, bitwise ops, Pow and comparisons are constexpr, so constants such as decimal
+// multipliers fold at compile time. Division, Sqrt and string conversion are run time only.
 struct uint256 {
 	uint256() = default;
-	uint256(const uint256&);
-	uint256& operator=(const uint256&);
-	explicit uint256(const int256&);
-	explicit uint256(uint64_t);
+	uint256(const uint256&) = default;
+	uint256& operator=(const uint256&) = default;
+	constexpr explicit uint256(const int256&);
+	constexpr explicit uint256(uint64_t);
 
 	int256& Signed();
 	const int256& Signed() const;
@@ -42,59 +230,60 @@ struct uint256 {
 	static uint256 FromString(const char*, uint32_t length = 0, uint32_t base = 10, bool* out_error = 0);
 	std::string ToString(uint32_t base = 10, const char* customDictionary = 0) const;
 
-	uint256 operator+(const uint256&) const;
-	uint256& operator+=(const uint256&);
-	uint256 operator-(const uint256&) const;
-	uint256& operator-=(const uint256&);
-	uint256 operator*(const uint256&) const;
-	uint256& operator*=(const uint256&);
+	constexpr uint256 operator+(const uint256&) const;
+	constexpr uint256& operator+=(const uint256&);
+	constexpr uint256 operator-(const uint256&) const;
+	constexpr uint256& operator-=(const uint256&);
+	constexpr uint256 operator*(const uint256&) const;
+	constexpr uint256& operator*=(const uint256&);
 	uint256 operator/(const uint256&) const;
 	uint256& operator/=(const uint256&);
 	uint256 operator%(const uint256&) const;
 	uint256& operator%=(const uint256&);
 
-	uint256 operator~() const;
-	uint256 operator&(const uint256&) const;
-	uint256& operator&=(const uint256&);
-	uint256 operator|(const uint256&) const;
-	uint256& operator|=(const uint256&);
-	uint256 operator^(const uint256&) const;
-	uint256& operator^=(const uint256&);
-	uint256 operator<<(int nbits) const;
-	uint256& operator<<=(int nbits);
-	uint256 operator>>(int nbits) const;
-	uint256& operator>>=(int nbits);
-
-	int Compare(const uint256&) const;
-	bool operator<(const uint256& o) const { return Compare(o) < 0; }
-	bool operator<=(const uint256& o) const { return Compare(o) <= 0; }
-	bool operator>(const uint256& o) const { return Compare(o) > 0; }
-	bool operator>=(const uint256& o) const { return Compare(o) >= 0; }
-	bool operator==(const uint256& o) const { return Compare(o) == 0; }
-	bool operator!=(const uint256& o) const { return Compare(o) != 0; }
-	bool operator!() const;
-	explicit operator bool() const;
-	explicit operator uint64_t() const;
-	bool Is8ByteSafe() const;
-
-	uint256& operator++();
-	uint256 operator++(int);
-	uint256& operator--();
-	uint256 operator--(int);
-
-	uint256 Pow(const uint256& e) const;
+	constexpr uint256 operator~() const;
+	constexpr uint256 operator&(const uint256&) const;
+	constexpr uint256& operator&=(const uint256&);
+	constexpr uint256 operator|(const uint256&) const;
+	constexpr uint256& operator|=(const uint256&);
+	constexpr uint256 operator^(const uint256&) const;
+	constexpr uint256& operator^=(const uint256&);
+	constexpr uint256 operator<<(int nbits) const;
+	constexpr uint256& operator<<=(int nbits);
+	constexpr uint256 operator>>(int nbits) const;
+	constexpr uint256& operator>>=(int nbits);
+
+	constexpr int Compare(const uint256&) const;
+	constexpr bool operator<(const uint256& o) const { return Compare(o) < 0; }
+	constexpr bool operator<=(const uint256& o) const { return Compare(o) <= 0; }
+	constexpr bool operator>(const uint256& o) const { return Compare(o) > 0; }
+	constexpr bool operator>=(const uint256& o) const { return Compare(o) >= 0; }
+	constexpr bool operator==(const uint256& o) const { return Compare(o) == 0; }
+	constexpr bool operator!=(const uint256& o) const { return Compare(o) != 0; }
+	constexpr bool operator!() const;
+	constexpr explicit operator bool() const;
+	constexpr explicit operator uint64_t() const;
+	constexpr bool Is8ByteSafe() const;
+
+	constexpr uint256& operator++();
+	constexpr uint256 operator++(int);
+	constexpr uint256& operator--();
+	constexpr uint256 operator--(int);
+
+	constexpr uint256 Pow(const uint256& e) const;
 	uint256 Sqrt() const;
 
   private:
-	uint32_t bits[8];
+	friend struct int256;
+	uint64_t words[4]; // little-endian 64-bit limbs
 };
 
 struct int256 {
 	int256() = default;
-	int256(const int256&);
-	int256& operator=(const int256&);
-	explicit int256(const uint256&);
-	explicit int256(int64_t);
+	int256(const int256&) = default;
+	int256& operator=(const int256&) = default;
+	constexpr explicit int256(const uint256&);
+	constexpr explicit int256(int64_t);
 
 	uint256& Unsigned();
 	const uint256& Unsigned() const;
@@ -105,54 +294,55 @@ struct int256 {
 	static int256 FromString(const char*, int length = 0, uint32_t base = 10);
 	std::string ToString(uint32_t base = 10, const char* customDictionary = 0, char negative = '-') const;
 
-	int256 Abs() const;
-	int256 operator-() const;
-	int256 operator+(const int256&) const;
-	int256& operator+=(const int256&);
-	int256 operator-(const int256&) const;
-	int256& operator-=(const int256&);
-	int256 operator*(const int256&) const;
-	int256& operator*=(const int256&);
+	constexpr int256 Abs() const;
+	constexpr int256 operator-() const;
+	constexpr int256 operator+(const int256&) const;
+	constexpr int256& operator+=(const int256&);
+	constexpr int256 operator-(const int256&) const;
+	constexpr int256& operator-=(const int256&);
+	constexpr int256 operator*(const int256&) const;
+	constexpr int256& operator*=(const int256&);
 	int256 operator/(const int256&) const;
 	int256& operator/=(const int256&);
 	int256 operator%(const int256&) const;
 	int256& operator%=(const int256&);
 
-	int256 operator~() const;
-	int256 operator&(const int256&) const;
-	int256& operator&=(const int256&);
-	int256 operator|(const int256&) const;
-	int256& operator|=(const int256&);
-	int256 operator^(const int256&) const;
-	int256& operator^=(const int256&);
-	int256 operator<<(int nbits) const;
-	int256& operator<<=(int nbits);
+	constexpr int256 operator~() const;
+	constexpr int256 operator&(const int256&) const;
+	constexpr int256& operator&=(const int256&);
+	constexpr int256 operator|(const int256&) const;
+	constexpr int256& operator|=(const int256&);
+	constexpr int256 operator^(const int256&) const;
+	constexpr int256& operator^=(const int256&);
+	constexpr int256 operator<<(int nbits) const;
+	constexpr int256& operator<<=(int nbits);
 	int256 operator>>(int nbits) const;
 	int256& operator>>=(int nbits);
 
-	int Compare(const int256&) const;
-	bool operator<(const int256& o) const { return Compare(o) < 0; }
-	bool operator<=(const int256& o) const { return Compare(o) <= 0; }
-	bool operator>(const int256& o) const { return Compare(o) > 0; }
-	bool operator>=(const int256& o) const { return Compare(o) >= 0; }
-	bool operator==(const int256& o) const { return Compare(o) == 0; }
-	bool operator!=(const int256& o) const { return Compare(o) != 0; }
-	bool operator!() const;
-	explicit operator bool() const;
-	explicit operator int64_t() const;
-	bool Is8ByteSafe() const;
-	bool IsNegative() const;
-
-	int256& operator++();
-	int256 operator++(int);
-	int256& operator--();
-	int256 operator--(int);
+	constexpr int Compare(const int256&) const;
+	constexpr bool operator<(const int256& o) const { return Compare(o) < 0; }
+	constexpr bool operator<=(const int256& o) const { return Compare(o) <= 0; }
+	constexpr bool operator>(const int256& o) const { return Compare(o) > 0; }
+	constexpr bool operator>=(const int256& o) const { return Compare(o) >= 0; }
+	constexpr bool operator==(const int256& o) const { return Compare(o) == 0; }
+	constexpr bool operator!=(const int256& o) const { return Compare(o) != 0; }
+	constexpr bool operator!() const;
+	constexpr explicit operator bool() const;
+	constexpr explicit operator int64_t() const;
+	constexpr bool Is8ByteSafe() const;
+	constexpr bool IsNegative() const;
+
+	constexpr int256& operator++();
+	constexpr int256 operator++(int);
+	constexpr int256& operator--();
+	constexpr int256 operator--(int);
 
   private:
-	uint32_t bits[8];
+	friend struct uint256;
+	uint64_t words[4]; // little-endian 64-bit limbs, two's complement
 
-	inline void TwosComplimentInPlace();
-	inline int256 TwosCompliment() const;
+	constexpr void TwosComplimentInPlace();
+	constexpr int256 TwosCompliment() const;
 };
 
 struct intx_pod;
@@ -222,17 +412,33 @@ struct intx {
 		return big.Signed();
 	}
 
-	//intx& operator+=(const intx& o);
-	//intx& operator-=(const intx& o);
+	// Arithmetic stays on int64 while both operands are small and the result does not overflow. Otherwise it is done
+	// in 256 bits, and results that fit back into int64 return to the small form.
 	intx operator+(const intx& o) const;
 	intx operator-(const intx& o) const;
-	bool operator>(const intx& o) const;
+	intx operator*(const intx& o) const;
+	intx operator/(const intx& o) const;
+	intx& operator+=(const intx& o) { return *this = *this + o; }
+	intx& operator-=(const intx& o) { return *this = *this - o; }
+	intx& operator*=(const intx& o) { return *this = *this * o; }
+	intx& operator/=(const intx& o) { return *this = *this / o; }
+
+	int Compare(const intx& o) const;
+	bool operator<(const intx& o) const { return Compare(o) < 0; }
+	bool operator<=(const intx& o) const { return Compare(o) <= 0; }
+	bool operator>(const intx& o) const { return Compare(o) > 0; }
+	bool operator>=(const intx& o) const { return Compare(o) >= 0; }
 	bool operator==(const intx& o) const;
+	bool operator!=(const intx& o) const { return !(*this == o); }
 
 	operator intx_pod&() { return *(intx_pod*)this; }
 	operator const intx_pod&() const { return *(intx_pod*)this; }
 
   private:
+	// The value as int256, without promoting the stored form
+	int256 Wide() const { return isBig ? big.Signed() : int256((int64_t)normal); }
+	static intx FromWide(const int256& o) { return o.Is8ByteSafe() ? intx((int64_t)o) : intx(o); }
+
 	void MakeBig() const
 	{
 		if( isBig )
@@ -254,4 +460,344 @@ struct intx_pod {
 static_assert(sizeof(intx) == sizeof(intx_pod));
 static_assert(alignof(intx) == alignof(intx_pod));
 
+//------------------------------------------------------------------------------
+constexpr uint256::uint256(uint64_t i) : words{ i, 0, 0, 0 }
+{
+}
+constexpr uint256::uint256(const int256& o) : words{ o.words[0], o.words[1], o.words[2], o.words[3] }
+{
+}
+
+constexpr uint256 uint256::operator+(const uint256& o) const
+{
+	uint256 r{};
+	Int256Limbs::Add(words, o.words, r.words);
+	return r;
+}
+constexpr uint256& uint256::operator+=(const uint256& o)
+{
+	Int256Limbs::Add(words, o.words, words);
+	return *this;
+}
+constexpr uint256 uint256::operator-(const uint256& o) const
+{
+	uint256 r{};
+	Int256Limbs::Sub(words, o.words, r.words);
+	return r;
+}
+constexpr uint256& uint256::operator-=(const uint256& o)
+{
+	Int256Limbs::Sub(words, o.words, words);
+	return *this;
+}
+constexpr uint256 uint256::operator*(const uint256& o) const
+{
+	uint256 r{};
+	Int256Limbs::Mul(words, o.words, r.words);
+	return r;
+}
+constexpr uint256& uint256::operator*=(const uint256& o)
+{
+	Int256Limbs::Mul(words, o.words, words);
+	return *this;
+}
+
+constexpr uint256 uint256::operator~() const
+{
+	uint256 r{};
+	for( int i = 0; i != 4; ++i )
+		r.words[i] = ~words[i];
+	return r;
+}
+constexpr uint256 uint256::operator&(const uint256& o) const
+{
+	uint256 r = *this;
+	return r &= o;
+}
+constexpr uint256& uint256::operator&=(const uint256& o)
+{
+	for( int i = 0; i != 4; ++i )
+		words[i] &= o.words[i];
+	return *this;
+}
+constexpr uint256 uint256::operator|(const uint256& o) const
+{
+	uint256 r = *this;
+	return r |= o;
+}
+constexpr uint256& uint256::operator|=(const uint256& o)
+{
+	for( int i = 0; i != 4; ++i )
+		words[i] |= o.words[i];
+	return *this;
+}
+constexpr uint256 uint256::operator^(const uint256& o) const
+{
+	uint256 r = *this;
+	return r ^= o;
+}
+constexpr uint256& uint256::operator^=(const uint256& o)
+{
+	for( int i = 0; i != 4; ++i )
+		words[i] ^= o.words[i];
+	return *this;
+}
+
+constexpr uint256 uint256::operator<<(int nbits) const
+{
+	uint256 r{};
+	Int256Limbs::ShiftLeft(words, r.words, nbits);
+	return r;
+}
+constexpr uint256& uint256::operator<<=(int nbits)
+{
+	Int256Limbs::ShiftLeft(words, words, nbits);
+	return *this;
+}
+constexpr uint256 uint256::operator>>(int nbits) const
+{
+	uint256 r{};
+	Int256Limbs::ShiftRight(words, r.words, nbits);
+	return r;
+}
+constexpr uint256& uint256::operator>>=(int nbits)
+{
+	Int256Limbs::ShiftRight(words, words, nbits);
+	return *this;
+}
+
+constexpr int uint256::Compare(const uint256& o) const
+{
+	return Int256Limbs::Compare(words, o.words);
+}
+constexpr bool uint256::operator!() const
+{
+	return Int256Limbs::IsZero(words);
+}
+constexpr uint256::operator bool() const
+{
+	return !Int256Limbs::IsZero(words);
+}
+constexpr uint256::operator uint64_t() const
+{
+	if( words[1] | words[2] | words[3] )
+		return UINT64_MAX;
+	return words[0];
+}
+constexpr bool uint256::Is8ByteSafe() const
+{
+	if( words[1] | words[2] | words[3] )
+		return false;
+	return (int64_t)words[0] >= 0; // only report 63byte unsigned values as safe!
+}
+
+constexpr uint256& uint256::operator++()
+{
+	Int256Limbs::Increment(words);
+	return *this;
+}
+constexpr uint256 uint256::operator++(int)
+{
+	uint256 copy = *this;
+	Int256Limbs::Increment(words);
+	return copy;
+}
+constexpr uint256& uint256::operator--()
+{
+	Int256Limbs::Decrement(words);
+	return *this;
+}
+constexpr uint256 uint256::operator--(int)
+{
+	uint256 copy = *this;
+	Int256Limbs::Decrement(words);
+	return copy;
+}
+
+constexpr uint256 uint256::Pow(const uint256& e) const
+{
+	CarbonAssert(e <= uint256(0xff), "max iterations violated");
+	// Square-and-multiply; the product wraps modulo 2^256 just like repeated multiplication
+	uint256 result(1);
+	uint256 base = *this;
+	for( uint64_t n = e.words[0]; n; n >>= 1 )
+	{
+		if( n & 1 )
+			result *= base;
+		if( n > 1 )
+			base *= base;
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------------
+constexpr int256::int256(const uint256& o) : words{ o.words[0], o.words[1], o.words[2], o.words[3] }
+{
+}
+constexpr int256::int256(int64_t i) : words{ (uint64_t)i, i < 0 ? ~0ULL : 0, i < 0 ? ~0ULL : 0, i < 0 ? ~0ULL : 0 }
+{
+}
+
+constexpr bool int256::IsNegative() const
+{
+	return words[3] >> 63;
+}
+
+constexpr void int256::TwosComplimentInPlace()
+{
+	Int256Limbs::Negate(words, words);
+}
+constexpr int256 int256::TwosCompliment() const
+{
+	int256 r{};
+	Int256Limbs::Negate(words, r.words);
+	return r;
+}
+constexpr int256 int256::Abs() const
+{
+	return IsNegative() ? TwosCompliment() : *this;
+}
+constexpr int256 int256::operator-() const
+{
+	return TwosCompliment();
+}
+
+constexpr int256 int256::operator+(const int256& o) const
+{
+	int256 r{};
+	Int256Limbs::Add(words, o.words, r.words);
+	return r;
+}
+constexpr int256& int256::operator+=(const int256& o)
+{
+	Int256Limbs::Add(words, o.words, words);
+	return *this;
+}
+constexpr int256 int256::operator-(const int256& o) const
+{
+	int256 r{};
+	Int256Limbs::Sub(words, o.words, r.words);
+	return r;
+}
+constexpr int256& int256::operator-=(const int256& o)
+{
+	Int256Limbs::Sub(words, o.words, words);
+	return *this;
+}
+constexpr int256 int256::operator*(const int256& o) const
+{
+	// The low 256 bits of a two's complement product do not depend on the operand signs
+	int256 r{};
+	Int256Limbs::Mul(words, o.words, r.words);
+	return r;
+}
+constexpr int256& int256::operator*=(const int256& o)
+{
+	Int256Limbs::Mul(words, o.words, words);
+	return *this;
+}
+
+constexpr int256 int256::operator~() const
+{
+	return int256(~uint256(*this));
+}
+constexpr int256 int256::operator&(const int256& o) const
+{
+	return int256(uint256(*this) & uint256(o));
+}
+constexpr int256& int256::operator&=(const int256& o)
+{
+	return *this = *this & o;
+}
+constexpr int256 int256::operator|(const int256& o) const
+{
+	return int256(uint256(*this) | uint256(o));
+}
+constexpr int256& int256::operator|=(const int256& o)
+{
+	return *this = *this | o;
+}
+constexpr int256 int256::operator^(const int256& o) const
+{
+	return int256(uint256(*this) ^ uint256(o));
+}
+constexpr int256& int256::operator^=(const int256& o)
+{
+	return *this = *this ^ o;
+}
+
+constexpr int256 int256::operator<<(int nbits) const
+{
+	int256 r{};
+	Int256Limbs::ShiftLeft(words, r.words, nbits);
+	return r;
+}
+constexpr int256& int256::operator<<=(int nbits)
+{
+	Int256Limbs::ShiftLeft(words, words, nbits);
+	return *this;
+}
+
+constexpr int int256::Compare(const int256& o) const
+{
+	bool n1 = IsNegative();
+	bool n2 = o.IsNegative();
+	if( n1 && !n2 )
+		return -1;
+	if( !n1 && n2 )
+		return 1;
+	// Two's complement values of the same sign order the same way as their unsigned bit patterns
+	return Int256Limbs::Compare(words, o.words);
+}
+constexpr bool int256::operator!() const
+{
+	return Int256Limbs::IsZero(words);
+}
+constexpr int256::operator bool() const
+{
+	return !Int256Limbs::IsZero(words);
+}
+constexpr int256::operator int64_t() const
+{
+	int64_t result = 0;
+	if( *this <= int256(INT64_MIN) )
+		result = INT64_MIN;
+	if( *this >= int256(INT64_MAX) )
+		result = INT64_MAX;
+	else
+		result = (int64_t)words[0];
+	return result;
+}
+constexpr bool int256::Is8ByteSafe() const
+{
+	const uint64_t expected = IsNegative() ? ~0ULL : 0;
+	if( words[1] != expected || words[2] != expected || words[3] != expected )
+		return false;
+	// only report 63byte unsigned values as safe!
+	return ((int64_t)words[0] < 0) == IsNegative();
+}
+
+constexpr int256& int256::operator++()
+{
+	Int256Limbs::Increment(words);
+	return *this;
+}
+constexpr int256 int256::operator++(int)
+{
+	int256 copy = *this;
+	Int256Limbs::Increment(words);
+	return copy;
+}
+constexpr int256& int256::operator--()
+{
+	Int256Limbs::Decrement(words);
+	return *this;
+}
+constexpr int256 int256::operator--(int)
+{
+	int256 copy = *this;
+	Int256Limbs::Decrement(words);
+	return copy;
+}
+
 } // namespace phantasma::carbon
@@ -12,20 +12,174 @@
 #ifndef ARRAY_SIZE
 #define ARRAY_SIZE(a) (sizeof(a) / sizeof((a)[0]))
 #endif
-// tiny-bignum-c
-extern "C" {
-#undef require
-#define require(a, b) CarbonAssert(a, b)
-#include "External/tiny-bignum-c/bn_impl.h"
-}
-static_assert(sizeof(bn) == sizeof(uint256));
-static_assert(sizeof(bn) == sizeof(int256));
-inline struct bn* B(const uint256& u) { return (bn*)&u; }
-inline struct bn* B(const int256& u) { return (bn*)&u; }
-#ifdef THIS
-#undef THIS
+
+//------------------------------------------------------------------------------
+// Division kernels, see Int256.h for the rest
+namespace Int256Limbs {
+
+// (hi:lo) / d, requires hi < d so the quotient fits in 64 bits
+inline uint64_t Div(uint64_t hi, uint64_t lo, uint64_t d, uint64_t& rem)
+{
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+	uint64_t q;
+	__asm__("divq %4" : "=a"(q), "=d"(rem) : "a"(lo), "d"(hi), "rm"(d));
+	return q;
+#elif defined(__SIZEOF_INT128__)
+	unsigned __int128 n = ((unsigned __int128)hi << 64) | lo;
+	rem = (uint64_t)(n % d);
+	return (uint64_t)(n / d);
+#elif defined(_MSC_VER) && defined(_M_X64) && _MSC_VER >= 1920
+	unsigned long long r;
+	uint64_t q = _udiv128(hi, lo, d, &r);
+	rem = r;
+	return q;
+#else
+	// Restoring division, one bit at a time
+	uint64_t q = 0;
+	for( int i = 63; i >= 0; --i )
+	{
+		uint64_t top = hi >> 63;
+		hi = (hi << 1) | (lo >> 63);
+		lo <<= 1;
+		q <<= 1;
+		if( top || hi >= d )
+		{
+			hi -= d;
+			q |= 1;
+		}
+	}
+	rem = hi;
+	return q;
+#endif
+}
+inline int CountLeadingZeros(uint64_t x)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return x ? __builtin_clzll(x) : 64;
+#elif defined(_MSC_VER) && defined(_M_X64)
+	unsigned long index;
+	return _BitScanReverse64(&index, x) ? 63 - (int)index : 64;
+#else
+	int n = 0;
+	for( uint64_t bit = 1ULL << 63; bit && !(x & bit); bit >>= 1 )
+		++n;
+	return n;
 #endif
-#define THIS ((bn*)this)
+}
+// Number of significant limbs
+inline int Length(const uint64_t* a)
+{
+	int n = Count;
+	while( n && !a[n - 1] )
+		--n;
+	return n;
+}
+// Divides by a single limb, returning the remainder. q may alias a.
+inline uint64_t DivSmall(const uint64_t* a, uint64_t d, uint64_t* q)
+{
+	uint64_t rem = 0;
+	for( int i = Count; i-- > 0; )
+		q[i] = Div(rem, a[i], d, rem);
+	return rem;
+}
+// Word-level long division (Knuth, TAOCP vol. 2, algorithm 4.3.1 D). Either output may be null or alias an input.
+// Division by zero yields a zero quotient and leaves the dividend as the remainder.
+inline void DivMod(const uint64_t* a, const uint64_t* b, uint64_t* quotient, uint64_t* remainder)
+{
+	uint64_t q[Count] = {};
+	uint64_t r[Count] = {};
+	const int n = Length(b);
+	const int m = Length(a);
+	if( n == 0 )
+	{
+		PHANTASMA_EXCEPTION("division by zero");
+		memcpy(r, a, sizeof(r));
+	}
+	else if( m < n || (m == n && Compare(a, b) < 0) )
+	{
+		memcpy(r, a, sizeof(r));
+	}
+	else if( n == 1 )
+	{
+		r[0] = DivSmall(a, b[0], q);
+	}
+	else
+	{
+		// Normalize so the divisor's top limb has its high bit set
+		const int s = CountLeadingZeros(b[n - 1]);
+		uint64_t vn[Count];
+		uint64_t un[Count + 1];
+		for( int i = n - 1; i > 0; --i )
+			vn[i] = (b[i] << s) | (s ? b[i - 1] >> (64 - s) : 0);
+		vn[0] = b[0] << s;
+		un[m] = s ? a[m - 1] >> (64 - s) : 0;
+		for( int i = m - 1; i > 0; --i )
+			un[i] = (a[i] << s) | (s ? a[i - 1] >> (64 - s) : 0);
+		un[0] = a[0] << s;
+
+		for( int j = m - n; j >= 0; --j )
+		{
+			// Estimate the quotient limb from the top two limbs, then correct it with the third
+			uint64_t qhat, rhat;
+			bool rhatOverflow = false;
+			if( un[j + n] >= vn[n - 1] )
+			{
+				qhat = ~0ULL;
+				rhat = un[j + n - 1] + vn[n - 1];
+				rhatOverflow = rhat < vn[n - 1] || un[j + n] > vn[n - 1];
+			}
+			else
+				qhat = Div(un[j + n], un[j + n - 1], vn[n - 1], rhat);
+			while( !rhatOverflow )
+			{
+				uint64_t hi;
+				uint64_t lo = Mul(qhat, vn[n - 2], hi);
+				if( hi < rhat || (hi == rhat && lo <= un[j + n - 2]) )
+					break;
+				--qhat;
+				rhat += vn[n - 1];
+				rhatOverflow = rhat < vn[n - 1];
+			}
+
+			// Multiply and subtract
+			uint64_t carry = 0;
+			uint8_t borrow = 0;
+			for( int i = 0; i != n; ++i )
+			{
+				uint64_t hi;
+				uint64_t lo = Mul(qhat, vn[i], hi);
+				uint8_t c = 0;
+				lo = AddCarry(lo, carry, c);
+				carry = hi + c;
+				un[i + j] = SubBorrow(un[i + j], lo, borrow);
+			}
+			un[j + n] = SubBorrow(un[j + n], carry, borrow);
+
+			// The estimate was one too large, add the divisor back
+			if( borrow )
+			{
+				--qhat;
+				uint8_t c = 0;
+				for( int i = 0; i != n; ++i )
+					un[i + j] = AddCarry(un[i + j], vn[i], c);
+				un[j + n] += c;
+			}
+			q[j] = qhat;
+		}
+
+		for( int i = 0; i != n; ++i )
+			r[i] = (un[i] >> s) | (s ? un[i + 1] << (64 - s) : 0);
+	}
+	if( quotient )
+		memcpy(quotient, q, sizeof(q));
+	if( remainder )
+		memcpy(remainder, r, sizeof(r));
+}
+
+} // namespace Int256Limbs
+static_assert(sizeof(uint256) == 32);
+static_assert(sizeof(int256) == 32);
+
 
 //------------------------------------------------------------------------------
 // Read/Write helpers for uint256/int256/intx
@@ -158,27 +312,33 @@ inline std::string uint256::ToString(uint32_t _base, const char* customDictionar
 	const char* dictionary = customDictionary ? customDictionary : s_dictionary;
 	CarbonAssert(_base > 1 && (_base <= 16 || customDictionary));
 	CarbonAssert(strlen(dictionary) >= _base);
-	if( bignum_is_zero(THIS) )
+	if( !*this )
 		return "0";
-	uint256 remainder;
-	uint256 base(_base);
+	// Divide by the largest power of the base that fits in a limb, then split each remainder into digits
+	uint64_t chunk = _base;
+	int chunkDigits = 1;
+	while( chunk <= UINT64_MAX / _base )
+	{
+		chunk *= _base;
+		++chunkDigits;
+	}
 	uint256 temp = *this;
-	std::string result;
-	result.reserve(32);
+	char buffer[256];
+	char* const end = buffer + sizeof(buffer);
+	char* p = end;
 	for( ;; )
 	{
-		uint256 next;
-		bignum_divmod(B(temp), B(base), B(next), B(remainder));
-		uint32_t digit = remainder.bits[0];
-		CarbonAssert(digit < _base);
-		char c = dictionary[digit];
-		result.append(1, c);
-		if( !next )
+		uint64_t remainder = Int256Limbs::DivSmall(temp.words, chunk, temp.words);
+		const bool last = !temp;
+		for( int i = 0; i != chunkDigits && (remainder || !last); ++i )
+		{
+			*--p = dictionary[remainder % _base];
+			remainder /= _base;
+		}
+		if( last )
 			break;
-		temp = next;
 	}
-	std::reverse(result.begin(), result.end());
-	return result;
+	return std::string(p, end);
 }
 
 inline std::string int256::ToString(uint32_t base, const char* customDictionary, char negative) const
@@ -192,27 +352,87 @@ inline std::string int256::ToString(uint32_t base, const char* customDictionary,
 	return result;
 }
 
+//------------------------------------------------------------------------------
+// Overflow-checked int64 arithmetic for the small intx form. Each returns false if the exact result doesn't fit.
+namespace IntXSmall {
+
+#if defined(__GNUC__) || defined(__clang__)
+inline bool Add(int64_t a, int64_t b, int64_t& r) { return !__builtin_add_overflow(a, b, &r); }
+inline bool Sub(int64_t a, int64_t b, int64_t& r) { return !__builtin_sub_overflow(a, b, &r); }
+inline bool Mul(int64_t a, int64_t b, int64_t& r) { return !__builtin_mul_overflow(a, b, &r); }
+#else
+inline bool Add(int64_t a, int64_t b, int64_t& r)
+{
+	r = (int64_t)((uint64_t)a + (uint64_t)b);
+	return ((a ^ r) & (b ^ r)) >= 0; // overflowed only if both operands' signs differ from the result's
+}
+inline bool Sub(int64_t a, int64_t b, int64_t& r)
+{
+	r = (int64_t)((uint64_t)a - (uint64_t)b);
+	return ((a ^ b) & (a ^ r)) >= 0;
+}
+inline bool Mul(int64_t a, int64_t b, int64_t& r)
+{
+	r = (int64_t)((uint64_t)a * (uint64_t)b);
+	if( a == 0 || b == 0 )
+		return true;
+	if( (a == -1 && b == INT64_MIN) || (b == -1 && a == INT64_MIN) )
+		return false;
+	return r / b == a;
+}
+#endif
+inline bool Div(int64_t a, int64_t b, int64_t& r)
+{
+	if( b == 0 || (a == INT64_MIN && b == -1) ) // division by zero reports through the 256-bit path
+		return false;
+	r = a / b;
+	return true;
+}
+
+} // namespace IntXSmall
+
 inline intx intx::operator+(const intx& o) const
 {
-	const int256 &a = *this, b = o;
-	return a + b;
+	int64_t r;
+	if( !isBig && !o.isBig && IntXSmall::Add((int64_t)normal, (int64_t)o.normal, r) )
+		return intx(r);
+	return FromWide(Wide() + o.Wide());
 }
 inline intx intx::operator-(const intx& o) const
 {
-	const int256 &a = *this, b = o;
-	return a - b;
+	int64_t r;
+	if( !isBig && !o.isBig && IntXSmall::Sub((int64_t)normal, (int64_t)o.normal, r) )
+		return intx(r);
+	return FromWide(Wide() - o.Wide());
 }
-inline bool intx::operator>(const intx& o) const
+inline intx intx::operator*(const intx& o) const
 {
-	const int256 &a = *this, b = o;
-	return a > b;
+	int64_t r;
+	if( !isBig && !o.isBig && IntXSmall::Mul((int64_t)normal, (int64_t)o.normal, r) )
+		return intx(r);
+	return FromWide(Wide() * o.Wide());
+}
+inline intx intx::operator/(const intx& o) const
+{
+	int64_t r;
+	if( !isBig && !o.isBig && IntXSmall::Div((int64_t)normal, (int64_t)o.normal, r) )
+		return intx(r);
+	return FromWide(Wide() / o.Wide());
+}
+inline int intx::Compare(const intx& o) const
+{
+	if( !isBig && !o.isBig )
+	{
+		const int64_t a = (int64_t)normal, b = (int64_t)o.normal;
+		return a < b ? -1 : (a > b ? 1 : 0);
+	}
+	return Wide().Compare(o.Wide());
 }
 inline bool intx::operator==(const intx& o) const
 {
 	if( !isBig && !o.isBig )
 		return normal == o.normal;
-	const int256 &a = *this, b = o;
-	return a == b;
+	return Wide() == o.Wide();
 }
 
 inline intx intx::FromString(const char* str, uint32_t strLength, uint32_t radix, bool* out_error)
@@ -296,346 +516,60 @@ inline const uint256& int256::Unsigned() const { return (const uint256&)*this; }
 inline int256& uint256::Signed() { return (int256&)*this; }
 inline const int256& uint256::Signed() const { return (const int256&)*this; }
 
-inline uint256::uint256(const uint256& o)
-{
-	bignum_assign(THIS, B(o));
-}
-inline uint256& uint256::operator=(const uint256& o)
-{
-	if( this != &o )
-	{
-		bignum_assign(THIS, B(o));
-	}
-	return *this;
-}
-inline int256::int256(const uint256& o)
-{
-	bignum_assign(THIS, B(o));
-}
-inline int256& int256::operator=(const int256& o)
-{
-	if( this != &o )
-	{
-		bignum_assign(THIS, B(o));
-	}
-	return *this;
-}
-inline uint256::uint256(uint64_t i)
-{
-	bignum_from_int(THIS, i);
-}
-
-inline uint256 uint256::operator+(const uint256& o) const
-{
-	uint256 r;
-	bignum_add(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator+=(const uint256& o)
-{
-	bignum_add(THIS, B(o), THIS);
-	return *this;
-}
-inline uint256 uint256::operator-(const uint256& o) const
-{
-	uint256 r;
-	bignum_sub(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator-=(const uint256& o)
-{
-	bignum_sub(THIS, B(o), THIS);
-	return *this;
-}
-inline uint256 uint256::operator*(const uint256& o) const
-{
-	uint256 r;
-	bignum_mul(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator*=(const uint256& o)
-{
-	uint256 a = *this;
-	bignum_mul(B(a), B(o), THIS);
-	return *this;
-}
 inline uint256 uint256::operator/(const uint256& o) const
 {
 	uint256 r;
-	bignum_div(THIS, B(o), B(r));
+	Int256Limbs::DivMod(words, o.words, r.words, nullptr);
 	return r;
 }
 inline uint256& uint256::operator/=(const uint256& o)
 {
-	bignum_div(THIS, B(o), THIS);
+	Int256Limbs::DivMod(words, o.words, words, nullptr);
 	return *this;
 }
 inline uint256 uint256::operator%(const uint256& o) const
 {
 	uint256 r;
-	bignum_mod(THIS, B(o), B(r));
+	Int256Limbs::DivMod(words, o.words, nullptr, r.words);
 	return r;
 }
 inline uint256& uint256::operator%=(const uint256& o)
 {
-	bignum_mod(THIS, B(o), THIS);
-	return *this;
-}
-
-inline uint256 uint256::operator~() const
-{
-	uint256 r;
-	bignum_not(THIS, B(r));
-	return r;
-}
-inline uint256 uint256::operator&(const uint256& o) const
-{
-	uint256 r;
-	bignum_and(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator&=(const uint256& o)
-{
-	bignum_and(THIS, B(o), THIS);
-	return *this;
-}
-inline uint256 uint256::operator|(const uint256& o) const
-{
-	uint256 r;
-	bignum_or(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator|=(const uint256& o)
-{
-	bignum_or(THIS, B(o), THIS);
-	return *this;
-}
-inline uint256 uint256::operator^(const uint256& o) const
-{
-	uint256 r;
-	bignum_xor(THIS, B(o), B(r));
-	return r;
-}
-inline uint256& uint256::operator^=(const uint256& o)
-{
-	bignum_xor(THIS, B(o), THIS);
-	return *this;
-}
-
-inline uint256 uint256::operator<<(int nbits) const
-{
-	uint256 r;
-	bignum_lshift(THIS, B(r), nbits);
-	return r;
-}
-inline uint256& uint256::operator<<=(int nbits)
-{
-	bignum_lshift(THIS, THIS, nbits);
-	return *this;
-}
-inline uint256 uint256::operator>>(int nbits) const
-{
-	uint256 r;
-	bignum_rshift(THIS, B(r), nbits);
-	return r;
-}
-inline uint256& uint256::operator>>=(int nbits)
-{
-	bignum_rshift(THIS, THIS, nbits);
-	return *this;
-}
-
-inline int uint256::Compare(const uint256& o) const
-{
-	return bignum_cmp(THIS, B(o));
-}
-inline bool uint256::operator!() const
-{
-	return bignum_is_zero(THIS);
-}
-inline uint256::operator bool() const
-{
-	return !bignum_is_zero(THIS);
-}
-inline uint256::operator uint64_t() const
-{
-	if( *this >= uint256(UINT64_MAX) )
-		return UINT64_MAX;
-	uint64_t result;
-	memcpy(&result, this, 8);
-	return result;
-}
-inline bool uint256::Is8ByteSafe() const
-{
-	bn* self = THIS;
-	static_assert(sizeof(DTYPE) == 4);
-	static_assert(BN_ARRAY_SIZE == 8);
-	for( int i = 2; i != BN_ARRAY_SIZE; ++i )
-		if( self->array[i] )
-			return false;
-	int64_t test;
-	memcpy(&test, this, 8);
-	if( test < 0 )
-		return false; // only report 63byte unsigned values as safe!
-	return true;
-}
-
-inline uint256& uint256::operator++()
-{
-	bignum_inc(THIS);
+	Int256Limbs::DivMod(words, o.words, nullptr, words);
 	return *this;
 }
-inline uint256 uint256::operator++(int)
-{
-	uint256 copy = *this;
-	bignum_inc(THIS);
-	return copy;
-}
-inline uint256& uint256::operator--()
-{
-	bignum_dec(THIS);
-	return *this;
-}
-inline uint256 uint256::operator--(int)
-{
-	uint256 copy = *this;
-	bignum_dec(THIS);
-	return copy;
-}
 
-inline uint256 uint256::Pow(const uint256& e) const
-{
-	uint256 r;
-	bignum_pow(THIS, B(e), B(r), 0xff);
-	return r;
-}
 inline uint256 uint256::Sqrt() const
 {
-	uint256 r;
-	bignum_isqrt(THIS, B(r));
-	return r;
-}
-
-//------------------------------------------------------------------------------
-inline bool int256::IsNegative() const
-{
-	static_assert(sizeof(int256::bits) == 32);
-	static_assert(sizeof(int256::bits) / sizeof(int256::bits[0]) == 8);
-	static_assert(sizeof(int256::bits[0]) == 4);
-	return bits[7] & 0x80000000;
-}
-
-inline void int256::TwosComplimentInPlace()
-{
-	bignum_not(THIS, THIS);
-	bignum_inc(THIS);
-}
-inline int256 int256::TwosCompliment() const
-{
-	int256 r;
-	bignum_not(THIS, B(r));
-	bignum_inc(B(r));
-	return r;
-}
-inline int256 int256::Abs() const
-{
-	return IsNegative() ? TwosCompliment() : *this;
-}
-inline int256 int256::operator-() const
-{
-	return TwosCompliment();
-}
-
-inline int256::int256(const int256& o)
-{
-	bignum_assign(THIS, B(o));
-}
-inline int256::int256(int64_t i)
-{
-	memcpy(bits, &i, 8);
-	memset(bits + 2, i < 0 ? 0xFF : 0x00, 32 - 8);
-}
-
-inline int256 int256::operator+(const int256& o) const
-{
-	int256 r;
-	bignum_add(THIS, B(o), B(r));
-	return r;
-}
-inline int256& int256::operator+=(const int256& o)
-{
-	bignum_add(THIS, B(o), THIS);
-	return *this;
-}
-inline int256 int256::operator-(const int256& o) const
-{
-	int256 r;
-	bignum_sub(THIS, B(o), B(r));
-	return r;
-}
-inline int256& int256::operator-=(const int256& o)
-{
-	bignum_sub(THIS, B(o), THIS);
-	return *this;
-}
-inline int256 int256::operator*(const int256& o) const
-{
-	bool n1 = IsNegative();
-	bool n2 = o.IsNegative();
-	int256 r;
-	if( !n1 && !n2 )
-		bignum_mul(THIS, B(o), B(r));
-	else if( n1 && n2 )
+	// Binary search kept step-for-step identical to the validator runtime, including its wrapping mid*mid
+	uint256 low(0);
+	uint256 high = *this;
+	uint256 mid = (high >> 1) + uint256(1);
+	while( high > low )
 	{
-		int256 a = TwosCompliment();
-		int256 b = o.TwosCompliment();
-		bignum_mul(B(a), B(b), B(r));
-	}
-	else if( n1 )
-	{
-		int256 a = TwosCompliment();
-		bignum_mul(B(a), B(o), B(r));
-		r.TwosComplimentInPlace();
-	}
-	else
-	{
-		CarbonAssert(n2);
-		int256 b = o.TwosCompliment();
-		bignum_mul(THIS, B(b), B(r));
-		r.TwosComplimentInPlace();
+		if( mid * mid > *this )
+		{
+			high = mid;
+			--high;
+		}
+		else
+			low = mid;
+		mid = ((high - low) >> 1) + low + uint256(1);
 	}
-	return r;
-}
-inline int256& int256::operator*=(const int256& o)
-{
-	return *this = (*this * o);
+	return low;
 }
+
 inline int256 int256::operator/(const int256& o) const
 {
-	bool n1 = IsNegative();
-	bool n2 = o.IsNegative();
+	// Truncates towards zero: divide the magnitudes, then restore the sign
+	const bool n1 = IsNegative();
+	const bool n2 = o.IsNegative();
+	int256 a = n1 ? TwosCompliment() : *this;
+	int256 b = n2 ? o.TwosCompliment() : o;
 	int256 r;
-	if( !n1 && !n2 )
-		bignum_div(THIS, B(o), B(r));
-	else if( n1 && n2 )
-	{
-		int256 a = TwosCompliment();
-		int256 b = o.TwosCompliment();
-		bignum_div(B(a), B(b), B(r));
-	}
-	else if( n1 )
-	{
-		int256 a = TwosCompliment();
-		bignum_div(B(a), B(o), B(r));
-		r.TwosComplimentInPlace();
-	}
-	else
-	{
-		CarbonAssert(n2);
-		int256 b = o.TwosCompliment();
-		bignum_div(THIS, B(b), B(r));
+	Int256Limbs::DivMod(a.words, b.words, r.words, nullptr);
+	if( n1 != n2 )
 		r.TwosComplimentInPlace();
-	}
 	return r;
 }
 inline int256& int256::operator/=(const int256& o)
@@ -643,138 +577,6 @@ inline int256& int256::operator/=(const int256& o)
 	return *this = (*this / o);
 }
 
-inline int256 int256::operator~() const
-{
-	int256 r;
-	bignum_not(THIS, B(r));
-	return r;
-}
-inline int256 int256::operator&(const int256& o) const
-{
-	int256 r;
-	bignum_and(THIS, B(o), B(r));
-	return r;
-}
-inline int256& int256::operator&=(const int256& o)
-{
-	bignum_and(THIS, B(o), THIS);
-	return *this;
-}
-inline int256 int256::operator|(const int256& o) const
-{
-	int256 r;
-	bignum_or(THIS, B(o), B(r));
-	return r;
-}
-inline int256& int256::operator|=(const int256& o)
-{
-	bignum_or(THIS, B(o), THIS);
-	return *this;
-}
-inline int256 int256::operator^(const int256& o) const
-{
-	int256 r;
-	bignum_xor(THIS, B(o), B(r));
-	return r;
-}
-inline int256& int256::operator^=(const int256& o)
-{
-	bignum_xor(THIS, B(o), THIS);
-	return *this;
-}
-
-inline int256 int256::operator<<(int nbits) const
-{
-	int256 r;
-	bignum_lshift(THIS, B(r), nbits);
-	return r;
-}
-inline int256& int256::operator<<=(int nbits)
-{
-	bignum_lshift(THIS, THIS, nbits);
-	return *this;
-}
-
-inline int int256::Compare(const int256& o) const
-{
-	bool n1 = IsNegative();
-	bool n2 = o.IsNegative();
-	if( n1 && !n2 )
-		return -1;
-	if( !n1 && n2 )
-		return 1;
-	if( n1 && n2 )
-		return -bignum_cmp(B(TwosCompliment()), B(o.TwosCompliment()));
-	return bignum_cmp(THIS, B(o));
-}
-inline bool int256::operator!() const
-{
-	return bignum_is_zero(THIS);
-}
-inline int256::operator bool() const
-{
-	return !bignum_is_zero(THIS);
-}
-inline int256::operator int64_t() const
-{
-	int64_t result;
-	if( *this <= int256(INT64_MIN) )
-		result = INT64_MIN;
-	if( *this >= int256(INT64_MAX) )
-		result = INT64_MAX;
-	else
-		memcpy(&result, bits, 8);
-	return result;
-}
-inline bool int256::Is8ByteSafe() const
-{
-	bn* self = THIS;
-	static_assert(sizeof(DTYPE) == 4);
-	static_assert(BN_ARRAY_SIZE == 8);
-	uint32_t expected = IsNegative() ? 0xFFFFFFFFU : 0x0;
-	for( int i = 2; i != BN_ARRAY_SIZE; ++i )
-		if( self->array[i] != expected )
-			return false;
-	if( !IsNegative() )
-	{
-		int64_t test;
-		memcpy(&test, this, 8);
-		if( test < 0 )
-			return false; // only report 63byte unsigned values as safe!
-	}
-	else
-	{
-		int64_t test;
-		memcpy(&test, this, 8);
-		if( test >= 0 )
-			return false;
-	}
-	return true;
-}
-
-inline int256& int256::operator++()
-{
-	bignum_inc(THIS);
-	return *this;
-}
-inline int256 int256::operator++(int)
-{
-	int256 copy = *this;
-	bignum_inc(THIS);
-	return copy;
-}
-inline int256& int256::operator--()
-{
-	bignum_dec(THIS);
-	return *this;
-}
-inline int256 int256::operator--(int)
-{
-	int256 copy = *this;
-	bignum_dec(THIS);
-	return copy;
-}
-
 //------------------------------------------------------------------------------
 
 inline uint256 uint256::FromBytes(const ByteView& data)
@@ -847,5 +649,3 @@ inline std::string intx::ToStringUnsigned() const
 	return buf;
 }
 
-//------------------------------------------------------------------------------
-#undef THIS
@@ -0,0 +1,230 @@
+#pragma once
+#ifndef PHANTASMA_API_INCLUDED
+#error "Configure and include PhantasmaAPI.h first"
+#endif
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+#include "../Domain/DomainSettings.h"
+#include "DataBlockchain.h"
+
+namespace phantasma::carbon::Blockchain {
+
+// A transaction batch is a contiguous buffer of signed transactions, each framed as a uint32 byte length followed by
+// the SignedTxMsg encoding (the same framing as WriteArray).
+inline void WriteTxBatchEntry(const SignedTxMsg& tx, WriteView& w)
+{
+	WriteView counter;
+	Write(tx, counter);
+	Write4((uint32_t)counter.Size(), w);
+	Write(tx, w);
+}
+inline void WriteTxBatchEntry(ByteView encodedTx, WriteView& w)
+{
+	WriteArray(encodedTx, w);
+}
+
+// Finds the encoded transactions within a batch without decoding them. Fails on broken framing or when the batch
+// holds more than maxCount transactions.
+inline bool SplitTxBatch(ByteView batch, std::vector<ByteView>& out, size_t maxCount = DomainSettings::MaxTxPerBlock)
+{
+	out.clear();
+	ReadView reader((void*)batch.bytes, batch.length);
+	while( !reader.Finished() )
+	{
+		uint32_t length = 0;
+		ByteView entry;
+		if( out.size() == maxCount || !Read4(length, reader) || !reader.Advance(length, entry) )
+		{
+			out.clear();
+			return false;
+		}
+		out.push_back(entry);
+	}
+	return true;
+}
+
+struct DecodedTx {
+	SignedTxMsg tx{};
+	ByteView encoded{}; // this transaction's bytes within the batch, excluding the length prefix
+	bool ok = false;
+};
+
+// Decodes transaction batches across a pool of worker threads. Every worker (and the calling thread, which takes
+// part in each batch) decodes into its own arena, so the decoded transactions are only valid until the next call to
+// Decode or until the decoder is destroyed. In-place reads may also point into the batch buffer.
+class TxBatchDecoder
+{
+  public:
+	// Transactions are handed out to the threads in ranges of this many
+	static constexpr size_t RangeSize = 16;
+
+	// numThreads includes the calling thread; 0 picks one per hardware thread
+	explicit TxBatchDecoder(uint32_t numThreads = 0, size_t maxTxPerBatch = DomainSettings::MaxTxPerBlock)
+	    : m_maxTx(maxTxPerBatch)
+	{
+		if( !numThreads )
+			numThreads = std::max(1u, std::thread::hardware_concurrency());
+		m_workers.reserve(numThreads - 1);
+		for( uint32_t i = 1; i < numThreads; ++i )
+			m_workers.emplace_back([this]() { WorkerLoop(); });
+	}
+	~TxBatchDecoder()
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stop = true;
+		}
+		m_wake.notify_all();
+		for( std::thread& worker : m_workers )
+			worker.join();
+	}
+	TxBatchDecoder(const TxBatchDecoder&) = delete;
+	TxBatchDecoder& operator=(const TxBatchDecoder&) = delete;
+
+	uint32_t Threads() const { return (uint32_t)m_workers.size() + 1; }
+
+	// Decodes every transaction in the batch, with results[i] holding the i-th one. Returns false if the framing is
+	// broken (results is left empty) or if any transaction failed to decode (see DecodedTx::ok).
+	bool Decode(ByteView batch, std::vector<DecodedTx>& results, ReadView::Flags flags = ReadView::InPlace)
+	{
+		results.clear();
+		if( !SplitTxBatch(batch, m_entries, m_maxTx) )
+			return false;
+		results.resize(m_entries.size());
+
+		m_results = results.empty() ? nullptr : &results.front();
+		m_flags = flags;
+		m_next.store(0, std::memory_order_relaxed);
+		m_failed.store(false, std::memory_order_relaxed);
+		const bool parallel = !m_workers.empty() && m_entries.size() > RangeSize;
+		if( parallel )
+		{
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				m_pending = (uint32_t)m_workers.size();
+				++m_generation;
+			}
+			m_wake.notify_all();
+		}
+
+		m_arena.Clear();
+		DecodeRanges(m_arena);
+
+		if( parallel )
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_done.wait(lock, [this]() { return m_pending == 0; });
+		}
+		m_results = nullptr;
+		return !m_failed.load(std::memory_order_relaxed);
+	}
+
+  private:
+	void WorkerLoop()
+	{
+		// The arena lives on the worker's own thread so its chunks are recycled through that thread's ChunkPool
+		Allocator arena("TxBatchDecoder");
+		uint64_t seen = 0;
+		for( ;; )
+		{
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [&]() { return m_stop || m_generation != seen; });
+				if( m_stop )
+					return;
+				seen = m_generation;
+			}
+			arena.Clear();
+			DecodeRanges(arena);
+			{
+				std::lock_guard<std::mutex> lock(m_mutex);
+				if( --m_pending == 0 )
+					m_done.notify_one();
+			}
+		}
+	}
+
+	void DecodeRanges(Allocator& arena)
+	{
+		const size_t count = m_entries.size();
+		for( ;; )
+		{
+			const size_t begin = m_next.fetch_add(RangeSize, std::memory_order_relaxed);
+			if( begin >= count )
+				return;
+			const size_t end = std::min(begin + RangeSize, count);
+			for( size_t i = begin; i != end; ++i )
+			{
+				if( !DecodeOne(m_entries[i], m_results[i], arena) )
+					m_failed.store(true, std::memory_order_relaxed);
+			}
+		}
+	}
+
+	static bool ReadEntry(SignedTxMsg& tx, ReadView& reader, Allocator& arena)
+	{
+		bool ok = false;
+		PHANTASMA_TRY
+		{
+			ok = Read(tx, reader, arena) && reader.Finished();
+		}
+		PHANTASMA_CATCH_ALL()
+		{
+			ok = false;
+		}
+		return ok;
+	}
+
+	bool DecodeOne(ByteView encoded, DecodedTx& out, Allocator& arena)
+	{
+		const AllocatorCheckpoint checkpoint = arena.Checkpoint();
+		ReadView reader(encoded, arena, m_flags);
+		bool ok = false;
+#if defined(__cpp_exceptions) || defined(_CPPUNWIND)
+		// Running out of memory throws even when PHANTASMA_TRY does not catch anything, and escaping a worker thread
+		// would end the process, so it only fails this entry
+		try
+		{
+			ok = ReadEntry(out.tx, reader, arena);
+		}
+		catch( const std::bad_alloc& )
+		{
+			ok = false;
+		}
+#else
+		ok = ReadEntry(out.tx, reader, arena);
+#endif
+		out.encoded = encoded;
+		out.ok = ok;
+		if( !ok )
+		{
+			arena.RewindTo(checkpoint);
+			out.tx = SignedTxMsg{};
+		}
+		return ok;
+	}
+
+	const size_t m_maxTx;
+	Allocator m_arena{ "TxBatchDecoder" };
+	std::vector<ByteView> m_entries;
+	DecodedTx* m_results = nullptr;
+	ReadView::Flags m_flags = ReadView::InPlace;
+	std::atomic<size_t> m_next{ 0 };
+	std::atomic<bool> m_failed{ false };
+
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::condition_variable m_done;
+	uint64_t m_generation = 0;
+	uint32_t m_pending = 0;
+	bool m_stop = false;
+	std::vector<std::thread> m_workers;
+};
+
+} // namespace phantasma::carbon::Blockchain
@@ -4,6 +4,7 @@
 #include "../Utils/TextUtils.h"
 #include "../Numerics/Base58.h"
 #include "../Security/SecureString.h"
+#include "AddressTable.h"
 #include "EdDSA/Ed25519.h"
 
 namespace phantasma {
@@ -23,26 +24,46 @@ class Address : public Serializable
 	static constexpr int LengthInBytes = 34;
 	static constexpr int MaxPlatformNameLength = 10;
 	static constexpr Byte NullPublicKey[LengthInBytes] = {};
+	static_assert(AddressTable::BytesLength == LengthInBytes && AddressTable::MaxTextLength == TextLength, "AddressTable layout");
 
 	const String& Text() const
 	{
 		if( _text.empty() )
 		{
-			const Char* prefix;
+			AddressTable& table = AddressTable::Global();
+			const bool useTable = table.Enabled();
+			if( useTable )
+			{
+				Char cached[TextLength + 1];
+				const int cachedLength = table.FindText(_bytes, cached);
+				if( cachedLength )
+				{
+					cached[cachedLength] = 0;
+					_text = String(cached);
+					return _text;
+				}
+			}
+
+			Char prefix;
 			switch( Kind() )
 			{
 			case AddressKind::User:
-				prefix = PHANTASMA_LITERAL("P");
+				prefix = PHANTASMA_LITERAL('P');
 				break;
 			case AddressKind::Interop:
-				prefix = PHANTASMA_LITERAL("X");
+				prefix = PHANTASMA_LITERAL('X');
 				break;
 			default:
-				prefix = PHANTASMA_LITERAL("S");
+				prefix = PHANTASMA_LITERAL('S');
 				break;
 			}
-			_text.append(prefix);
-			_text.append(Base58::Encode(_bytes, LengthInBytes));
+			Char text[1 + Base58::EncodedLengthBound(LengthInBytes) + 1];
+			text[0] = prefix;
+			const int length = 1 + Base58::EncodeFixed<LengthInBytes>(text + 1, _bytes);
+			text[length] = 0;
+			_text = String(text);
+			if( useTable )
+				table.InsertText(_bytes, text, length);
 		}
 		return _text;
 	}
@@ -190,11 +211,18 @@ class Address : public Serializable
 			}
 		}
 
+		// Only texts that parsed successfully are recorded, so a hit skips the checks below
+		AddressTable& table = AddressTable::Global();
+		const bool useTable = table.Enabled();
+		Byte bytes[LengthInBytes];
+		if( useTable && table.FindBytes(text, textLength, bytes) )
+			return Address(bytes, LengthInBytes);
+
 		Char prefix = text[0];
-		Byte bytes[LengthInBytes + 1];
-		int decoded = Base58::Decode(bytes, LengthInBytes + 1, text + 1, textLength - 1);
+		bool invalidCharacter = false;
+		int decoded = Base58::DecodeFixed<LengthInBytes>(bytes, text + 1, textLength - 1, out_error ? &invalidCharacter : 0);
 
-		if( decoded != LengthInBytes )
+		if( invalidCharacter || decoded != LengthInBytes )
 		{
 			if( out_error )
 				*out_error = true;
@@ -250,6 +278,8 @@ class Address : public Serializable
 		}
 		break;
 		}
+		if( useTable )
+			table.InsertBytes(text, textLength, bytes);
 		return addr;
 	}
 
@@ -0,0 +1,127 @@
+#pragma once
+#ifndef PHANTASMA_API_INCLUDED
+#error "Configure and include PhantasmaAPI.h first"
+#endif
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Address.h"
+
+namespace phantasma {
+
+// Parses, validates and formats many addresses at once. Failures are reported in a status bitmap instead of through
+// exceptions or out_error: bit (i % 8) of status[i / 8] is set when the i-th text is a valid address. Work is split
+// into ranges of RangeSize entries, spread over numThreads threads (including the calling one; 0 picks one per
+// hardware thread). Ranges are a multiple of 8 entries, so no two threads ever write to the same status byte.
+class AddressBatch
+{
+  public:
+	static constexpr int RangeSize = 256;
+
+	static int StatusBytes(int count) { return (count + 7) / 8; }
+	static bool IsValid(const Byte* status, int index) { return (status[index / 8] >> (index % 8)) & 1; }
+
+	// Fills status (StatusBytes(count) bytes) and, when out is not null, out[i] with the parsed address or the null
+	// address for invalid text. Returns how many texts were valid.
+	static int FromText(const String* texts, int count, Address* out, Byte* status, int numThreads = 1)
+	{
+		return Run(count, numThreads, [&](int i)
+		    { return ParseOne(texts[i].c_str(), (int)texts[i].length(), out ? &out[i] : 0); },
+		    status);
+	}
+
+	// As above, for texts that are not held in Strings. lengths may be null for zero terminated texts.
+	static int FromText(const Char* const* texts, const int* lengths, int count, Address* out, Byte* status, int numThreads = 1)
+	{
+		return Run(count, numThreads, [&](int i)
+		    {
+			    const int length = !texts[i] ? 0 : lengths ? lengths[i] : (int)PHANTASMA_STRLEN(texts[i]);
+			    return ParseOne(texts[i], length, out ? &out[i] : 0);
+		    },
+		    status);
+	}
+
+	static int Validate(const String* texts, int count, Byte* status, int numThreads = 1)
+	{
+		return FromText(texts, count, 0, status, numThreads);
+	}
+
+	static void ToText(const Address* addresses, int count, String* out, int numThreads = 1)
+	{
+		Run(count, numThreads, [&](int i)
+		    {
+			    out[i] = addresses[i].Text();
+			    return true;
+		    },
+		    0);
+	}
+
+  private:
+	static bool ParseOne(const Char* text, int length, Address* out)
+	{
+		bool error = false;
+		Address address;
+		if( length > 0 )
+			address = Address::FromText(text, length, &error);
+		else
+			error = true;
+		if( out )
+			*out = error ? Address() : address;
+		return !error;
+	}
+
+	template<class Fn>
+	static int RunRanges(std::atomic<int>& next, int count, const Fn& fn, Byte* status)
+	{
+		int valid = 0;
+		for( ;; )
+		{
+			const int begin = next.fetch_add(RangeSize, std::memory_order_relaxed);
+			if( begin >= count )
+				return valid;
+			const int end = PHANTASMA_MIN(begin + RangeSize, count);
+			Byte bits = 0;
+			for( int i = begin; i != end; ++i )
+			{
+				const bool ok = fn(i);
+				valid += ok;
+				bits |= (Byte)(ok << (i % 8));
+				if( i % 8 == 7 || i + 1 == end )
+				{
+					if( status )
+						status[i / 8] = bits;
+					bits = 0;
+				}
+			}
+		}
+	}
+
+	template<class Fn>
+	static int Run(int count, int numThreads, const Fn& fn, Byte* status)
+	{
+		if( count <= 0 )
+			return 0;
+		if( numThreads <= 0 )
+			numThreads = (int)PHANTASMA_MAX(1u, std::thread::hardware_concurrency());
+		numThreads = PHANTASMA_MIN(numThreads, (count + RangeSize - 1) / RangeSize);
+
+		std::atomic<int> next{ 0 };
+		std::vector<int> valid(numThreads, 0);
+		std::vector<std::thread> workers;
+		workers.reserve(numThreads - 1);
+		for( int t = 1; t < numThreads; ++t )
+			workers.emplace_back([&, t]() { valid[t] = RunRanges(next, count, fn, status); });
+		valid[0] = RunRanges(next, count, fn, status);
+		for( std::thread& worker : workers )
+			worker.join();
+
+		int total = 0;
+		for( int v : valid )
+			total += v;
+		return total;
+	}
+};
+
+} // namespace phantasma
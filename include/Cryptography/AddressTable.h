@@ -0,0 +1,244 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace phantasma {
+
+// Process-wide cache of address bytes <-> text conversions, consulted by Address::Text and Address::FromText.
+// Disabled until SetCapacity is called with a non-zero size. The table is split into shards, each guarded by its
+// own mutex, and every shard is a small set-associative cache: a lookup touches one set of Ways entries, and a
+// full set replaces its least recently used entry, so memory stays bounded no matter how many addresses pass by.
+class AddressTable
+{
+  public:
+	static constexpr int BytesLength = 34;
+	static constexpr int MaxTextLength = 47;
+	static constexpr int Shards = 16;
+	static constexpr int Ways = 8;
+
+	struct Stats
+	{
+		UInt64 textHits = 0;   // Address::Text served from the table
+		UInt64 textMisses = 0; // Address::Text that had to Base58 encode
+		UInt64 parseHits = 0;   // Address::FromText served from the table
+		UInt64 parseMisses = 0; // Address::FromText that had to Base58 decode
+	};
+
+	static AddressTable& Global()
+	{
+		static AddressTable table;
+		return table;
+	}
+
+	bool Enabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+	// Rounds the capacity up to whole sets in every shard, and discards the current contents. 0 disables the table.
+	// Give it about four times the number of hot addresses, so that few sets overflow.
+	void SetCapacity(int entries)
+	{
+		const int perShard = entries <= 0 ? 0 : (entries + Shards * Ways - 1) / (Shards * Ways);
+		_enabled.store(false, std::memory_order_relaxed);
+		for( Shard& shard : _shards )
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.byBytes.assign(perShard * Ways, Entry());
+			shard.byText.assign(perShard * Ways, Entry());
+			shard.sets = perShard;
+		}
+		_capacity.store(perShard * Ways * Shards, std::memory_order_relaxed);
+		_enabled.store(perShard != 0, std::memory_order_relaxed);
+	}
+
+	int Capacity() const { return _capacity.load(std::memory_order_relaxed); }
+
+	void Clear()
+	{
+		for( Shard& shard : _shards )
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.byBytes.assign(shard.byBytes.size(), Entry());
+			shard.byText.assign(shard.byText.size(), Entry());
+		}
+	}
+
+	Stats GetStats()
+	{
+		Stats total;
+		for( Shard& shard : _shards )
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			total.textHits += shard.stats.textHits;
+			total.textMisses += shard.stats.textMisses;
+			total.parseHits += shard.stats.parseHits;
+			total.parseMisses += shard.stats.parseMisses;
+		}
+		return total;
+	}
+
+	void ResetStats()
+	{
+		for( Shard& shard : _shards )
+		{
+			std::lock_guard<std::mutex> lock(shard.mutex);
+			shard.stats = Stats();
+		}
+	}
+
+	// Copies the text of the address into text (MaxTextLength characters) and returns its length, or 0 on a miss
+	int FindText(const Byte* bytes, Char* text)
+	{
+		const UInt64 hash = Hash(bytes, BytesLength);
+		Shard& shard = ShardOf(hash);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		Entry* entry = shard.sets ? FindEntry(shard, shard.byBytes, hash, bytes, 0, 0) : 0;
+		if( !entry )
+		{
+			++shard.stats.textMisses;
+			return 0;
+		}
+		++shard.stats.textHits;
+		PHANTASMA_COPY(entry->text, entry->text + entry->textLength, text);
+		return entry->textLength;
+	}
+
+	// Copies the bytes of a previously parsed address text into bytes (BytesLength), returning false on a miss
+	bool FindBytes(const Char* text, int textLength, Byte* bytes)
+	{
+		if( textLength <= 0 || textLength > MaxTextLength )
+			return false;
+		const UInt64 hash = Hash(text, textLength);
+		Shard& shard = ShardOf(hash);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		Entry* entry = shard.sets ? FindEntry(shard, shard.byText, hash, 0, text, textLength) : 0;
+		if( !entry )
+		{
+			++shard.stats.parseMisses;
+			return false;
+		}
+		++shard.stats.parseHits;
+		PHANTASMA_COPY(entry->bytes, entry->bytes + BytesLength, bytes);
+		return true;
+	}
+
+	// Records the text an address formats to
+	void InsertText(const Byte* bytes, const Char* text, int textLength)
+	{
+		if( textLength <= 0 || textLength > MaxTextLength )
+			return;
+		const UInt64 hash = Hash(bytes, BytesLength);
+		Shard& shard = ShardOf(hash);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		if( shard.sets )
+			Store(shard, shard.byBytes, hash, bytes, text, textLength);
+	}
+
+	// Records an address text that parsed successfully
+	void InsertBytes(const Char* text, int textLength, const Byte* bytes)
+	{
+		if( textLength <= 0 || textLength > MaxTextLength )
+			return;
+		const UInt64 hash = Hash(text, textLength);
+		Shard& shard = ShardOf(hash);
+		std::lock_guard<std::mutex> lock(shard.mutex);
+		if( shard.sets )
+			Store(shard, shard.byText, hash, bytes, text, textLength);
+	}
+
+  private:
+	struct Entry
+	{
+		UInt64 hash = 0;
+		UInt32 lastUse = 0;
+		Byte textLength = 0; // 0 marks an empty entry
+		Byte bytes[BytesLength];
+		Char text[MaxTextLength];
+	};
+
+	struct Shard
+	{
+		std::mutex mutex;
+		PHANTASMA_VECTOR<Entry> byBytes;
+		PHANTASMA_VECTOR<Entry> byText;
+		int sets = 0;
+		UInt32 clock = 0;
+		Stats stats;
+	};
+
+	// FNV-1a with a final avalanche, since both the shard and the set are picked from a few bits of the result
+	template<class T>
+	static UInt64 Hash(const T* data, int length)
+	{
+		UInt64 hash = 14695981039346656037ull;
+		for( int i = 0; i < length; ++i )
+		{
+			hash ^= (UInt64)data[i];
+			hash *= 1099511628211ull;
+		}
+		hash ^= hash >> 33;
+		hash *= 0xff51afd7ed558ccdull;
+		hash ^= hash >> 33;
+		return hash;
+	}
+
+	Shard& ShardOf(UInt64 hash) { return _shards[(hash >> 60) % Shards]; }
+
+	static Entry* SetOf(const Shard& shard, PHANTASMA_VECTOR<Entry>& entries, UInt64 hash)
+	{
+		return &entries[(size_t)(hash % (UInt64)shard.sets) * Ways];
+	}
+
+	static Entry* FindEntry(Shard& shard, PHANTASMA_VECTOR<Entry>& entries, UInt64 hash, const Byte* bytes, const Char* text, int textLength)
+	{
+		Entry* set = SetOf(shard, entries, hash);
+		for( int i = 0; i < Ways; ++i )
+		{
+			Entry& entry = set[i];
+			if( entry.textLength == 0 || entry.hash != hash )
+				continue;
+			const bool match = bytes ? PHANTASMA_EQUAL(bytes, bytes + BytesLength, entry.bytes)
+			                         : entry.textLength == textLength && PHANTASMA_EQUAL(text, text + textLength, entry.text);
+			if( match )
+			{
+				entry.lastUse = ++shard.clock;
+				return &entry;
+			}
+		}
+		return 0;
+	}
+
+	static void Store(Shard& shard, PHANTASMA_VECTOR<Entry>& entries, UInt64 hash, const Byte* bytes, const Char* text, int textLength)
+	{
+		Entry* set = SetOf(shard, entries, hash);
+		Entry* victim = &set[0];
+		for( int i = 0; i < Ways; ++i )
+		{
+			Entry& entry = set[i];
+			if( entry.textLength == 0 )
+			{
+				victim = &entry;
+				break;
+			}
+			if( entry.hash == hash && PHANTASMA_EQUAL(bytes, bytes + BytesLength, entry.bytes) && entry.textLength == textLength &&
+			    PHANTASMA_EQUAL(text, text + textLength, entry.text) )
+			{
+				victim = &entry;
+				break;
+			}
+			// Unsigned difference keeps the ordering right when the clock wraps
+			if( (UInt32)(shard.clock - entry.lastUse) > (UInt32)(shard.clock - victim->lastUse) )
+				victim = &entry;
+		}
+		victim->hash = hash;
+		victim->lastUse = ++shard.clock;
+		victim->textLength = (Byte)textLength;
+		PHANTASMA_COPY(bytes, bytes + BytesLength, victim->bytes);
+		PHANTASMA_COPY(text, text + textLength, victim->text);
+	}
+
+	std::atomic<bool> _enabled{ false };
+	std::atomic<int> _capacity{ 0 };
+	Shard _shards[Shards];
+};
+
+} // namespace phantasma
@@ -6,6 +6,15 @@
 #error "You must supply a Ed25519 implementation"
 #endif
 
+// The signing context hooks are optional, but come as a set
+#if defined(PHANTASMA_Ed25519_SignerCreate) && (!defined(PHANTASMA_Ed25519_SignerSign) || !defined(PHANTASMA_Ed25519_SignerFree))
+#error "PHANTASMA_Ed25519_SignerCreate needs PHANTASMA_Ed25519_SignerSign and PHANTASMA_Ed25519_SignerFree"
+#endif
+
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+#include <mutex>
+#endif
+
 namespace phantasma {
 namespace Ed25519 {
 
@@ -47,6 +56,37 @@ inline ByteArray Sign(const Byte* message, int messageLength, const Byte* expand
 	return signed_message;
 }
 
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+// Holds the adapter's signing context for one key, so that repeated signatures skip decoding the key. The context
+// is created by the first Sign (which may come from several threads at once) and freed with the Signer; every call
+// must pass the same seed.
+class Signer
+{
+  public:
+	Signer() {}
+	~Signer()
+	{
+		if( m_context )
+			PHANTASMA_Ed25519_SignerFree(m_context);
+	}
+	Signer(const Signer&) = delete;
+	Signer& operator=(const Signer&) = delete;
+
+	// Writes a 64 byte signature, returning false when the adapter could not sign
+	bool Sign(Byte* signature, const Byte* message, int messageLength, const Byte* seed, int seedLength)
+	{
+		if( !signature || !message || !seed || seedLength != 32 )
+			return false;
+		std::call_once(m_created, [&]() { m_context = PHANTASMA_Ed25519_SignerCreate(seed, seedLength); });
+		return m_context && PHANTASMA_Ed25519_SignerSign(m_context, signature, 64, message, messageLength) == 64;
+	}
+
+  private:
+	std::once_flag m_created;
+	void* m_context = 0;
+};
+#endif
+
 inline bool Verify(const Byte* signature, int signatureLength, const Byte* message, int messageLength, const Byte* publicKey, int publicKeyLength)
 {
 	if( !signature || !message || !publicKey )
@@ -54,5 +94,47 @@ inline bool Verify(const Byte* signature, int signatureLength, const Byte* messa
 	return PHANTASMA_Ed25519_ValidateDetached(signature, signatureLength, message, messageLength, publicKey, publicKeyLength);
 }
 
+// Verifies count detached signatures (64 bytes each) against their messages and public keys (32 bytes each).
+// results, when not null, receives the outcome for every entry, so a failing batch still tells which signatures are
+// bad. Returns true when all of them are valid. Each signature is verified on its own, not through a combined batch
+// equation, so a batch costs as much as checking its entries one by one. Adapters may supply
+// PHANTASMA_Ed25519_ValidateDetachedBatch to share setup between the entries; it must report the same result per entry
+// as PHANTASMA_Ed25519_ValidateDetached.
+inline bool VerifyBatch(const Byte* const* messages, const int* messageLengths, const Byte* const* signatures, const Byte* const* publicKeys, int count, bool* results = 0)
+{
+	if( count <= 0 )
+		return true;
+	if( !messages || !messageLengths || !signatures || !publicKeys )
+	{
+		if( results )
+			for( int i = 0; i < count; ++i )
+				results[i] = false;
+		return false;
+	}
+#if defined(PHANTASMA_Ed25519_ValidateDetachedBatch)
+	if( results )
+		return PHANTASMA_Ed25519_ValidateDetachedBatch(signatures, messages, messageLengths, publicKeys, count, results) == count;
+	bool inlineResults[64];
+	std::unique_ptr<bool[]> heapResults;
+	bool* out = inlineResults;
+	if( count > 64 )
+	{
+		heapResults.reset(new bool[count]);
+		out = heapResults.get();
+	}
+	return PHANTASMA_Ed25519_ValidateDetachedBatch(signatures, messages, messageLengths, publicKeys, count, out) == count;
+#else
+	bool all = true;
+	for( int i = 0; i < count; ++i )
+	{
+		const bool ok = Verify(signatures[i], 64, messages[i], messageLengths[i], publicKeys[i], 32);
+		if( results )
+			results[i] = ok;
+		all &= ok;
+	}
+	return all;
+#endif
+}
+
 } // namespace Ed25519
 } // namespace phantasma
@@ -7,6 +7,8 @@
 
 namespace phantasma {
 
+class PhantasmaKeys;
+
 class Ed25519Signature
 {
   public:
@@ -102,6 +104,8 @@ class Ed25519Signature
 		ByteArray sign = Ed25519::Sign(message, messageLength, expandedPrivateKey.bytes, 64);
 		return Ed25519Signature(sign);
 	}
+	// Signs with the key's cached signing context when the adapter supports one (defined in KeyPair.h)
+	static Ed25519Signature Generate(const PhantasmaKeys& keypair, const Byte* message, int messageLength);
 	template<class IKeyPair>
 	static Ed25519Signature Generate(const IKeyPair& keypair, const ByteArray& message)
 	{
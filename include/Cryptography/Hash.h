@@ -6,6 +6,10 @@
 #include "../Utils/TextUtils.h"
 #include "SHA.h"
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 namespace phantasma {
 
 class Hash : public Serializable
@@ -247,6 +251,32 @@ class Hash : public Serializable
 		else
 			return Hash(input, inputLength);
 	}
+	// FromBytes for many inputs, with the ones that need hashing going through SHA256Many together
+	static void FromBytesMany(const ByteArray* inputs, Hash* outputs, int count)
+	{
+		PHANTASMA_VECTOR<const Byte*> pointers;
+		PHANTASMA_VECTOR<int> lengths;
+		PHANTASMA_VECTOR<int> indices;
+		for( int i = 0; i < count; ++i )
+		{
+			if( inputs[i].empty() )
+				outputs[i] = Hash();
+			else if( inputs[i].size() == Length )
+				outputs[i] = Hash(&inputs[i].front(), Length);
+			else
+			{
+				pointers.push_back(&inputs[i].front());
+				lengths.push_back((int)inputs[i].size());
+				indices.push_back(i);
+			}
+		}
+		if( indices.empty() )
+			return;
+		PHANTASMA_VECTOR<Byte> digests(indices.size() * Length);
+		SHA256Many(&pointers.front(), &lengths.front(), &digests.front(), (int)indices.size());
+		for( size_t j = 0; j != indices.size(); ++j )
+			outputs[indices[j]] = Hash(&digests[j * Length], Length);
+	}
 
 	template<class BinaryWriter>
 	void SerializeData(BinaryWriter& writer) const
@@ -305,21 +335,38 @@ class Hash : public Serializable
 	//public static class PoWUtils
 	int GetDifficulty() const
 	{
-		int result = 0;
-		for( int i = 0; i < Length; i++ )
-		{
-			Byte n = m_data[i];
+		return Difficulty(m_data);
+	}
 
-			for( int j = 0; j < 8; j++ )
-			{
-				if( (n & (1 << j)) != 0 )
-				{
-					result = 1 + (i << 3) + j;
-				}
-			}
+	// Number of leading zero bits of a 32 byte hash read as a little-endian number
+	static int Difficulty(const Byte* hash)
+	{
+		for( int word = Length / 8 - 1; word >= 0; --word )
+		{
+			UInt64 value = 0;
+			for( int i = 7; i >= 0; --i )
+				value = (value << 8) | hash[word * 8 + i];
+			if( value )
+				return (Length / 8 - 1 - word) * 64 + CountLeadingZeros(value);
 		}
+		return 256;
+	}
 
-		return 256 - result;
+  private:
+	static int CountLeadingZeros(UInt64 x)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		return __builtin_clzll(x);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		unsigned long index;
+		_BitScanReverse64(&index, x);
+		return 63 - (int)index;
+#else
+		int n = 0;
+		for( UInt64 bit = 1ULL << 63; !(x & bit); bit >>= 1 )
+			++n;
+		return n;
+#endif
 	}
 };
 
@@ -13,6 +13,12 @@ class PhantasmaKeys
 	PrivateKey privateKey;
 	ByteArray publicKey;
 	Address address;
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+	// Shared by copies of these keys, and freed with the last of them
+	std::shared_ptr<Ed25519::Signer> signer;
+#endif
+
+	friend class Ed25519Signature;
 
   public:
 #if defined(__GNUG__)
@@ -51,6 +57,16 @@ class PhantasmaKeys
 	}
 	PhantasmaKeys(const Byte* privateKey, int privateKeyLength)
 	    : privateKey(privateKey, privateKeyLength), publicKey(Ed25519::PublicKeyFromSeed(privateKey, privateKeyLength)), address(Address::FromKey(*this))
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+	    , signer(std::make_shared<Ed25519::Signer>())
+#endif
+	{
+	}
+	PhantasmaKeys(const PhantasmaKeys& other)
+	    : privateKey(other.privateKey), publicKey(other.publicKey), address(other.address)
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+	    , signer(other.signer)
+#endif
 	{
 	}
 
@@ -59,6 +75,9 @@ class PhantasmaKeys
 		privateKey = other.privateKey;
 		publicKey = other.publicKey;
 		address = other.address;
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+		signer = other.signer;
+#endif
 		return *this;
 	}
 
@@ -128,6 +147,20 @@ class PhantasmaKeys
 	}
 };
 
+inline Ed25519Signature Ed25519Signature::Generate(const PhantasmaKeys& keypair, const Byte* message, int messageLength)
+{
+#if defined(PHANTASMA_Ed25519_SignerCreate)
+	if( keypair.signer && message && messageLength > 0 )
+	{
+		Byte signature[Length];
+		SecureByteReader read = keypair.GetPrivateKey().Read();
+		if( keypair.signer->Sign(signature, message, messageLength, read.Bytes(), PrivateKey::Length) )
+			return Ed25519Signature(signature, Length);
+	}
+#endif
+	return Generate<PhantasmaKeys>(keypair, message, messageLength);
+}
+
 inline Address Address::FromWIF(const Char* wif, int wifStringLength)
 {
 	return PhantasmaKeys::FromWIF(wif, wifStringLength).GetAddress();
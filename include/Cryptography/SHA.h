@@ -4,6 +4,13 @@
 #error "You must supply a SHA256 implementation"
 #endif
 
+#include "SHA256Core.h"
+
+// The incremental hash hooks are optional, but come as a set
+#if defined(PHANTASMA_SHA256_STATE) && (!defined(PHANTASMA_SHA256_INIT) || !defined(PHANTASMA_SHA256_UPDATE) || !defined(PHANTASMA_SHA256_FINAL) || !defined(PHANTASMA_SHA256_EXPORT) || !defined(PHANTASMA_SHA256_IMPORT))
+#error "PHANTASMA_SHA256_STATE needs PHANTASMA_SHA256_INIT, _UPDATE, _FINAL, _EXPORT and _IMPORT"
+#endif
+
 namespace phantasma {
 
 #define PHANTASMA_SHA256_LENGTH 32
@@ -15,6 +22,16 @@ inline void SHA256(Byte* output, int outputSize, const Byte* input, int inputSiz
 		PHANTASMA_EXCEPTION("Invalid arguments");
 		return;
 	}
+#if defined(PHANTASMA_SIMD_X86) && defined(PHANTASMA_SHA256_BUILTIN)
+	// With the SHA extensions the built-in hash keeps up with the adaptors on long messages, and skips their
+	// per-call overhead on the short ones (keys, hashes, addresses) that make up most calls. Only adaptors that
+	// opt in are bypassed, so a PHANTASMA_SHA256 routed to a hardware module or audited library stays in charge
+	if( Cpu::HasSha() )
+	{
+		Sha256::Hash(output, input, (size_t)inputSize);
+		return;
+	}
+#endif
 	PHANTASMA_SHA256(output, outputSize, input, inputSize);
 }
 
@@ -26,4 +43,134 @@ inline ByteArray SHA256(const ByteArray& input)
 	return result;
 }
 
+// Hashes count independent messages with the built-in hash, writing the digests one after the other to outputs
+// (PHANTASMA_SHA256_LENGTH * count bytes). Much faster than one call per message on CPUs that have AVX2 but not the
+// SHA extensions, since eight messages go through each pass.
+inline void SHA256Many(const Byte* const* inputs, const int* inputLengths, Byte* outputs, int count)
+{
+	if( count <= 0 )
+		return;
+	if( !inputs || !inputLengths || !outputs )
+	{
+		PHANTASMA_EXCEPTION("Invalid arguments");
+		return;
+	}
+	PHANTASMA_VECTOR<size_t> lengths(count);
+	for( int i = 0; i < count; ++i )
+	{
+		if( inputLengths[i] < 0 || (!inputs[i] && inputLengths[i]) )
+		{
+			PHANTASMA_EXCEPTION("Invalid arguments");
+			return;
+		}
+		lengths[i] = (size_t)inputLengths[i];
+	}
+	Sha256::HashMany(inputs, &lengths.front(), outputs, (size_t)count);
+}
+
+inline void SHA256Many(const ByteArray* inputs, Byte* outputs, int count)
+{
+	if( count <= 0 )
+		return;
+	PHANTASMA_VECTOR<const Byte*> pointers(count);
+	PHANTASMA_VECTOR<int> lengths(count);
+	for( int i = 0; i < count; ++i )
+	{
+		pointers[i] = inputs[i].empty() ? 0 : &inputs[i].front();
+		lengths[i] = (int)inputs[i].size();
+	}
+	SHA256Many(&pointers.front(), &lengths.front(), outputs, count);
+}
+
+// Hashes a message given in pieces. Export and Import save and restore a hash in progress (e.g. to hash several
+// messages that share a prefix), in a format that does not depend on the adapter.
+class SHA256Hasher
+{
+  public:
+	SHA256Hasher() { Init(); }
+
+	void Init()
+	{
+#if defined(PHANTASMA_SHA256_STATE)
+		PHANTASMA_SHA256_INIT(m_state);
+#else
+		Sha256::Init(m_state);
+#endif
+	}
+
+	void Update(const Byte* input, int inputLength)
+	{
+		if( inputLength <= 0 )
+			return;
+		if( !input )
+		{
+			PHANTASMA_EXCEPTION("Invalid arguments");
+			return;
+		}
+#if defined(PHANTASMA_SHA256_STATE)
+		PHANTASMA_SHA256_UPDATE(m_state, input, (size_t)inputLength);
+#else
+		Sha256::Update(m_state, input, (size_t)inputLength);
+#endif
+	}
+	void Update(const ByteArray& input)
+	{
+		if( !input.empty() )
+			Update(&input.front(), (int)input.size());
+	}
+
+	// Writes the digest and starts over with an empty message
+	void Final(Byte* output, int outputSize)
+	{
+		if( !output || outputSize != PHANTASMA_SHA256_LENGTH )
+		{
+			PHANTASMA_EXCEPTION("Invalid arguments");
+			return;
+		}
+#if defined(PHANTASMA_SHA256_STATE)
+		PHANTASMA_SHA256_FINAL(m_state, output);
+#else
+		Sha256::Final(m_state, output);
+#endif
+		Init();
+	}
+	ByteArray Final()
+	{
+		ByteArray result;
+		result.resize(PHANTASMA_SHA256_LENGTH);
+		Final(&result.front(), PHANTASMA_SHA256_LENGTH);
+		return result;
+	}
+
+	void Export(Sha256::Midstate& midstate) const
+	{
+#if defined(PHANTASMA_SHA256_STATE)
+		PHANTASMA_SHA256_EXPORT(m_state, midstate);
+#else
+		midstate = m_state;
+#endif
+	}
+	void Import(const Sha256::Midstate& midstate)
+	{
+#if defined(PHANTASMA_SHA256_STATE)
+		PHANTASMA_SHA256_IMPORT(m_state, midstate);
+#else
+		m_state = midstate;
+#endif
+	}
+
+	// For writers that forward their output to a callback, such as BinaryWriter::ToSink
+	static void Sink(void* hasher, const Byte* bytes, size_t length)
+	{
+		((SHA256Hasher*)hasher)->Update(bytes, (int)length);
+	}
+
+  private:
+#if defined(PHANTASMA_SHA256_STATE)
+	PHANTASMA_SHA256_STATE m_state;
+#else
+	Sha256::Midstate m_state;
+#endif
+};
+
 } // namespace phantasma
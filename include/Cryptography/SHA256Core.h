@@ -0,0 +1,432 @@
+#pragma once
+#ifndef PHANTASMA_API_INCLUDED
+#error "Configure and include PhantasmaAPI.h first"
+#endif
+
+#include "../Utils/CpuFeatures.h"
+
+namespace phantasma {
+
+// The SHA-256 compression function on its own, for callers that need the intermediate state (such as resuming from
+// the hash of a fixed message prefix), and a portable incremental hash built on it. Whole messages are still hashed
+// through PHANTASMA_SHA256, and SHA256Hasher prefers the adapter's incremental hash when there is one.
+// Compress uses the SHA extensions when the CPU has them, and HashMany hashes eight independent messages per pass
+// with AVX2 when it does not.
+namespace Sha256 {
+
+constexpr int BlockLength = 64;
+constexpr int DigestLength = 32;
+constexpr int StateWords = 8;
+
+constexpr UInt32 RoundConstants[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline void Init(UInt32* state)
+{
+	state[0] = 0x6a09e667;
+	state[1] = 0xbb67ae85;
+	state[2] = 0x3c6ef372;
+	state[3] = 0xa54ff53a;
+	state[4] = 0x510e527f;
+	state[5] = 0x9b05688c;
+	state[6] = 0x1f83d9ab;
+	state[7] = 0x5be0cd19;
+}
+
+inline UInt32 LoadBE32(const Byte* p)
+{
+	return ((UInt32)p[0] << 24) | ((UInt32)p[1] << 16) | ((UInt32)p[2] << 8) | (UInt32)p[3];
+}
+
+inline void StoreBE32(Byte* p, UInt32 v)
+{
+	p[0] = (Byte)(v >> 24);
+	p[1] = (Byte)(v >> 16);
+	p[2] = (Byte)(v >> 8);
+	p[3] = (Byte)v;
+}
+
+inline UInt32 Rotr(UInt32 x, int n)
+{
+	return (x >> n) | (x << (32 - n));
+}
+
+inline void CompressScalar(UInt32* state, const Byte* blocks, size_t numBlocks)
+{
+	for( ; numBlocks; --numBlocks, blocks += BlockLength )
+	{
+		UInt32 w[64];
+		for( int i = 0; i < 16; ++i )
+			w[i] = LoadBE32(blocks + i * 4);
+		for( int i = 16; i < 64; ++i )
+		{
+			const UInt32 s0 = Rotr(w[i - 15], 7) ^ Rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+			const UInt32 s1 = Rotr(w[i - 2], 17) ^ Rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+			w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+		}
+
+		UInt32 a = state[0], b = state[1], c = state[2], d = state[3];
+		UInt32 e = state[4], f = state[5], g = state[6], h = state[7];
+		for( int i = 0; i < 64; ++i )
+		{
+			const UInt32 t1 = h + (Rotr(e, 6) ^ Rotr(e, 11) ^ Rotr(e, 25)) + ((e & f) ^ (~e & g)) + RoundConstants[i] + w[i];
+			const UInt32 t2 = (Rotr(a, 2) ^ Rotr(a, 13) ^ Rotr(a, 22)) + ((a & b) ^ (a & c) ^ (b & c));
+			h = g;
+			g = f;
+			f = e;
+			e = d + t1;
+			d = c;
+			c = b;
+			b = a;
+			a = t1 + t2;
+		}
+		state[0] += a;
+		state[1] += b;
+		state[2] += c;
+		state[3] += d;
+		state[4] += e;
+		state[5] += f;
+		state[6] += g;
+		state[7] += h;
+	}
+}
+
+#if defined(PHANTASMA_SIMD_X86)
+// The state is kept as ABEF / CDGH, the order sha256rnds2 works in. Each group of four rounds also extends the
+// message schedule by four words, from the four groups before it.
+PHANTASMA_TARGET_SHA
+inline void CompressSHANI(UInt32* state, const Byte* blocks, size_t numBlocks)
+{
+	const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bull, 0x0405060700010203ull);
+	__m128i dcba = _mm_loadu_si128((const __m128i*)&state[0]);
+	__m128i hgfe = _mm_loadu_si128((const __m128i*)&state[4]);
+	dcba = _mm_shuffle_epi32(dcba, 0xB1);
+	hgfe = _mm_shuffle_epi32(hgfe, 0x1B);
+	__m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+	__m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+
+	for( ; numBlocks; --numBlocks, blocks += BlockLength )
+	{
+		const __m128i abefStart = abef;
+		const __m128i cdghStart = cdgh;
+		__m128i w0 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 0)), byteSwap);
+		__m128i w1 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 16)), byteSwap);
+		__m128i w2 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 32)), byteSwap);
+		__m128i w3 = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(blocks + 48)), byteSwap);
+		for( int group = 0; group < 16; ++group )
+		{
+			__m128i msg = _mm_add_epi32(w0, _mm_loadu_si128((const __m128i*)&RoundConstants[group * 4]));
+			cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+			msg = _mm_shuffle_epi32(msg, 0x0E);
+			abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+
+			const __m128i next = _mm_sha256msg2_epu32(_mm_add_epi32(_mm_sha256msg1_epu32(w0, w1), _mm_alignr_epi8(w3, w2, 4)), w3);
+			w0 = w1;
+			w1 = w2;
+			w2 = w3;
+			w3 = next;
+		}
+		abef = _mm_add_epi32(abef, abefStart);
+		cdgh = _mm_add_epi32(cdgh, cdghStart);
+	}
+
+	const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+	const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+	_mm_storeu_si128((__m128i*)&state[0], _mm_blend_epi16(feba, dchg, 0xF0));
+	_mm_storeu_si128((__m128i*)&state[4], _mm_alignr_epi8(dchg, feba, 8));
+}
+
+PHANTASMA_TARGET_AVX2
+inline __m256i Rotr8(__m256i x, int n)
+{
+	return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n));
+}
+
+// Loads word `offset` .. offset + 7 of each lane's block, one lane per input row, into one vector per word
+PHANTASMA_TARGET_AVX2
+inline void LoadTransposed8(__m256i* w, const Byte* const* blocks, int offset)
+{
+	const __m256i byteSwap = _mm256_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll, 0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+	__m256i rows[8];
+	for( int lane = 0; lane < 8; ++lane )
+		rows[lane] = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i*)(blocks[lane] + offset * 4)), byteSwap);
+
+	const __m256i t0 = _mm256_unpacklo_epi32(rows[0], rows[1]);
+	const __m256i t1 = _mm256_unpackhi_epi32(rows[0], rows[1]);
+	const __m256i t2 = _mm256_unpacklo_epi32(rows[2], rows[3]);
+	const __m256i t3 = _mm256_unpackhi_epi32(rows[2], rows[3]);
+	const __m256i t4 = _mm256_unpacklo_epi32(rows[4], rows[5]);
+	const __m256i t5 = _mm256_unpackhi_epi32(rows[4], rows[5]);
+	const __m256i t6 = _mm256_unpacklo_epi32(rows[6], rows[7]);
+	const __m256i t7 = _mm256_unpackhi_epi32(rows[6], rows[7]);
+	const __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+	const __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+	const __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+	const __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+	const __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+	const __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+	const __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+	const __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+	w[offset + 0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+	w[offset + 1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+	w[offset + 2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+	w[offset + 3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+	w[offset + 4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+	w[offset + 5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+	w[offset + 6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+	w[offset + 7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// One block for each of eight independent hashes. state[i] holds word i of all eight chaining values.
+PHANTASMA_TARGET_AVX2
+inline void Compress8(__m256i* state, const Byte* const* blocks)
+{
+	__m256i w[16];
+	LoadTransposed8(w, blocks, 0);
+	LoadTransposed8(w, blocks, 8);
+
+	__m256i a = state[0], b = state[1], c = state[2], d = state[3];
+	__m256i e = state[4], f = state[5], g = state[6], h = state[7];
+	for( int i = 0; i < 64; ++i )
+	{
+		__m256i wi;
+		if( i < 16 )
+			wi = w[i];
+		else
+		{
+			const __m256i w15 = w[(i - 15) & 15];
+			const __m256i w2 = w[(i - 2) & 15];
+			const __m256i s0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8(w15, 7), Rotr8(w15, 18)), _mm256_srli_epi32(w15, 3));
+			const __m256i s1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8(w2, 17), Rotr8(w2, 19)), _mm256_srli_epi32(w2, 10));
+			wi = _mm256_add_epi32(_mm256_add_epi32(w[i & 15], s0), _mm256_add_epi32(w[(i - 7) & 15], s1));
+			w[i & 15] = wi;
+		}
+		const __m256i sigma1 = _mm256_xor_si256(_mm256_xor_si256(Rotr8(e, 6), Rotr8(e, 11)), Rotr8(e, 25));
+		const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+		const __m256i t1 = _mm256_add_epi32(_mm256_add_epi32(h, sigma1),
+		    _mm256_add_epi32(ch, _mm256_add_epi32(wi, _mm256_set1_epi32((int)RoundConstants[i]))));
+		const __m256i sigma0 = _mm256_xor_si256(_mm256_xor_si256(Rotr8(a, 2), Rotr8(a, 13)), Rotr8(a, 22));
+		const __m256i maj = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(c, _mm256_or_si256(a, b)));
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(d, t1);
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(t1, _mm256_add_epi32(sigma0, maj));
+	}
+	state[0] = _mm256_add_epi32(state[0], a);
+	state[1] = _mm256_add_epi32(state[1], b);
+	state[2] = _mm256_add_epi32(state[2], c);
+	state[3] = _mm256_add_epi32(state[3], d);
+	state[4] = _mm256_add_epi32(state[4], e);
+	state[5] = _mm256_add_epi32(state[5], f);
+	state[6] = _mm256_add_epi32(state[6], g);
+	state[7] = _mm256_add_epi32(state[7], h);
+}
+#endif
+
+// Runs numBlocks consecutive 64 byte blocks through the compression function
+inline void Compress(UInt32* state, const Byte* blocks, size_t numBlocks)
+{
+#if defined(PHANTASMA_SIMD_X86)
+	if( Cpu::HasSha() )
+	{
+		CompressSHANI(state, blocks, numBlocks);
+		return;
+	}
+#endif
+	CompressScalar(state, blocks, numBlocks);
+}
+
+// Writes the final padding for a message of totalLength bytes, whose last tailLength (< 64) bytes are already at the
+// start of block. Returns the number of blocks (1 or 2) to compress.
+inline int Pad(Byte* block, int tailLength, UInt64 totalLength)
+{
+	const int blocks = tailLength + 9 > BlockLength ? 2 : 1;
+	block[tailLength] = 0x80;
+	for( int i = tailLength + 1; i < blocks * BlockLength - 8; ++i )
+		block[i] = 0;
+	const UInt64 bits = totalLength * 8;
+	StoreBE32(block + blocks * BlockLength - 8, (UInt32)(bits >> 32));
+	StoreBE32(block + blocks * BlockLength - 4, (UInt32)bits);
+	return blocks;
+}
+
+inline void StoreDigest(Byte* output, const UInt32* state)
+{
+	for( int i = 0; i < StateWords; ++i )
+		StoreBE32(output + i * 4, state[i]);
+}
+
+// Hashes a whole message in one go
+inline void Hash(Byte* output, const Byte* input, size_t inputLength)
+{
+	UInt32 state[StateWords];
+	Init(state);
+	const size_t whole = inputLength / BlockLength;
+	if( whole )
+		Compress(state, input, whole);
+	Byte tail[2 * BlockLength];
+	const int tailLength = (int)(inputLength % BlockLength);
+	PHANTASMA_COPY(input + whole * BlockLength, input + inputLength, tail);
+	Compress(state, tail, (size_t)Pad(tail, tailLength, inputLength));
+	StoreDigest(output, state);
+}
+
+#if defined(PHANTASMA_SIMD_X86)
+// Eight messages at a time, longest last so that each group of eight has similar lengths. A lane whose message is
+// done keeps hashing a dummy block until the longest one in its group finishes; its digest is taken as it finishes.
+PHANTASMA_TARGET_AVX2
+inline void HashMany8(const Byte* const* inputs, const size_t* inputLengths, Byte* outputs, size_t count)
+{
+	PHANTASMA_VECTOR<size_t> order(count);
+	for( size_t i = 0; i != count; ++i )
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&](size_t x, size_t y) { return inputLengths[x] < inputLengths[y]; });
+
+	struct Lane
+	{
+		size_t message;
+		size_t wholeBlocks;
+		size_t blocks; // 0 for an unused lane
+		Byte tail[2 * BlockLength];
+	};
+	Lane lanes[8];
+	const Byte dummy[BlockLength] = {};
+
+	for( size_t first = 0; first < count; first += 8 )
+	{
+		size_t longest = 0;
+		for( int lane = 0; lane < 8; ++lane )
+		{
+			Lane& l = lanes[lane];
+			l.blocks = 0;
+			if( first + lane >= count )
+				continue;
+			l.message = order[first + lane];
+			const size_t length = inputLengths[l.message];
+			l.wholeBlocks = length / BlockLength;
+			const int tailLength = (int)(length % BlockLength);
+			PHANTASMA_COPY(inputs[l.message] + l.wholeBlocks * BlockLength, inputs[l.message] + length, l.tail);
+			l.blocks = l.wholeBlocks + (size_t)Pad(l.tail, tailLength, length);
+			longest = PHANTASMA_MAX(longest, l.blocks);
+		}
+
+		__m256i state[StateWords];
+		UInt32 iv[StateWords];
+		Init(iv);
+		for( int i = 0; i < StateWords; ++i )
+			state[i] = _mm256_set1_epi32((int)iv[i]);
+
+		for( size_t block = 0; block != longest; ++block )
+		{
+			const Byte* blocks[8];
+			bool finishing = false;
+			for( int lane = 0; lane < 8; ++lane )
+			{
+				const Lane& l = lanes[lane];
+				if( block >= l.blocks )
+					blocks[lane] = dummy;
+				else if( block < l.wholeBlocks )
+					blocks[lane] = inputs[l.message] + block * BlockLength;
+				else
+					blocks[lane] = l.tail + (block - l.wholeBlocks) * BlockLength;
+				finishing |= block + 1 == l.blocks;
+			}
+			Compress8(state, blocks);
+			if( !finishing )
+				continue;
+
+			alignas(32) UInt32 words[StateWords][8];
+			for( int i = 0; i < StateWords; ++i )
+				_mm256_store_si256((__m256i*)words[i], state[i]);
+			for( int lane = 0; lane < 8; ++lane )
+			{
+				if( block + 1 != lanes[lane].blocks )
+					continue;
+				Byte* output = outputs + lanes[lane].message * DigestLength;
+				for( int i = 0; i < StateWords; ++i )
+					StoreBE32(output + i * 4, words[i][lane]);
+			}
+		}
+	}
+}
+#endif
+
+// Hashes count independent messages, writing the digests one after the other to outputs (DigestLength * count bytes).
+// The SHA extensions hash one message at a time faster than any multi-buffer scheme, so eight-way AVX2 is only used
+// on CPUs that have AVX2 but lack them.
+inline void HashMany(const Byte* const* inputs, const size_t* inputLengths, Byte* outputs, size_t count)
+{
+#if defined(PHANTASMA_SIMD_X86)
+	if( count > 1 && !Cpu::HasSha() && Cpu::ActiveIsa() == Cpu::Isa::AVX2 )
+	{
+		HashMany8(inputs, inputLengths, outputs, count);
+		return;
+	}
+#endif
+	for( size_t i = 0; i != count; ++i )
+		Hash(outputs + i * DigestLength, inputs[i], inputLengths[i]);
+}
+
+// The complete state of an incremental hash: the chaining value, the number of bytes hashed so far, and the
+// (length % BlockLength) bytes that do not fill a block yet. Also the portable format for exporting a hash in progress.
+struct Midstate
+{
+	UInt32 state[StateWords];
+	UInt64 length;
+	Byte buffer[BlockLength];
+};
+
+inline void Init(Midstate& m)
+{
+	Init(m.state);
+	m.length = 0;
+}
+
+inline void Update(Midstate& m, const Byte* input, size_t inputLength)
+{
+	size_t buffered = (size_t)(m.length % BlockLength);
+	m.length += inputLength;
+	if( buffered )
+	{
+		const size_t take = PHANTASMA_MIN(inputLength, BlockLength - buffered);
+		PHANTASMA_COPY(input, input + take, m.buffer + buffered);
+		input += take;
+		inputLength -= take;
+		buffered += take;
+		if( buffered < (size_t)BlockLength )
+			return;
+		Compress(m.state, m.buffer, 1);
+	}
+	const size_t blocks = inputLength / BlockLength;
+	if( blocks )
+	{
+		Compress(m.state, input, blocks);
+		input += blocks * BlockLength;
+		inputLength -= blocks * BlockLength;
+	}
+	PHANTASMA_COPY(input, input + inputLength, m.buffer);
+}
+
+inline void Final(Midstate& m, Byte* output)
+{
+	Byte tail[2 * BlockLength];
+	const int buffered = (int)(m.length % BlockLength);
+	PHANTASMA_COPY(m.buffer, m.buffer + buffered, tail);
+	Compress(m.state, tail, (size_t)Pad(tail, buffered, m.length));
+	StoreDigest(output, m.state);
+}
+
+} // namespace Sha256
+} // namespace phantasma
@@ -5,6 +5,7 @@
 
 #include <ctype.h>
 #include "../Utils/ByteArrayUtils.h"
+#include "../Utils/CpuFeatures.h"
 
 namespace phantasma {
 namespace Base16 {
@@ -18,6 +19,260 @@ inline int AlphabetIndexOf(Char in)
 	return -1;
 }
 
+// Value of a hex digit of either case, or -1
+inline int NibbleOf(Char in)
+{
+	if( in >= '0' && in <= '9' )
+		return in - '0';
+	in |= 0x20;
+	if( in >= 'a' && in <= 'f' )
+		return in - 'a' + 10;
+	return -1;
+}
+
+// Bulk conversion of whole blocks. Each function handles as many full blocks as it can and returns the number of
+// bytes it produced; the caller finishes the tail, and any block holding an invalid character, one byte at a time.
+namespace Kernels {
+
+inline void EncodeScalar(Char* output, const Byte* input, int length, bool lowercase)
+{
+	const int letterOffset = lowercase ? 'a' - 10 : 'A' - 10;
+	for( int i = 0; i < length; i++ )
+	{
+		const int hi = input[i] >> 4;
+		const int lo = input[i] & 0xF;
+		output[i * 2] = (Char)(hi < 10 ? '0' + hi : letterOffset + hi);
+		output[i * 2 + 1] = (Char)(lo < 10 ? '0' + lo : letterOffset + lo);
+	}
+}
+
+// Decodes up to `length` bytes from 2 * length digits, stopping before the first invalid pair
+inline int DecodeScalar(Byte* output, const Char* input, int length)
+{
+	for( int i = 0; i < length; i++ )
+	{
+		const int A = NibbleOf(input[i * 2 + 0]);
+		const int B = NibbleOf(input[i * 2 + 1]);
+		if( A < 0 || B < 0 )
+			return i;
+		output[i] = (Byte)(A * 16 + B);
+	}
+	return length;
+}
+
+#if defined(PHANTASMA_SIMD_X86)
+inline __m128i DigitsSSE2(__m128i nibbles, __m128i letterOffset)
+{
+	const __m128i letters = _mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9));
+	return _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), _mm_and_si128(letters, letterOffset));
+}
+
+inline int EncodeSSE2(char* output, const Byte* input, int length, bool lowercase)
+{
+	const __m128i letterOffset = _mm_set1_epi8(lowercase ? 'a' - '0' - 10 : 'A' - '0' - 10);
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	int i = 0;
+	for( ; i + 16 <= length; i += 16 )
+	{
+		const __m128i in = _mm_loadu_si128((const __m128i*)(input + i));
+		const __m128i hi = DigitsSSE2(_mm_and_si128(_mm_srli_epi16(in, 4), mask), letterOffset);
+		const __m128i lo = DigitsSSE2(_mm_and_si128(in, mask), letterOffset);
+		_mm_storeu_si128((__m128i*)(output + i * 2), _mm_unpacklo_epi8(hi, lo));
+		_mm_storeu_si128((__m128i*)(output + i * 2 + 16), _mm_unpackhi_epi8(hi, lo));
+	}
+	return i;
+}
+
+// Nibble values of 16 digits, clearing `valid` where a character is not a hex digit
+inline __m128i NibblesSSE2(__m128i chars, __m128i& valid)
+{
+	const __m128i digit = _mm_sub_epi8(chars, _mm_set1_epi8('0'));
+	const __m128i letter = _mm_sub_epi8(_mm_or_si128(chars, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+	const __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+	const __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+	valid = _mm_and_si128(valid, _mm_or_si128(isDigit, isLetter));
+	return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// Joins the nibble pairs of 16 digits into the low byte of each 16-bit lane
+inline __m128i JoinSSE2(__m128i nibbles)
+{
+	const __m128i hi = _mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4);
+	return _mm_or_si128(hi, _mm_srli_epi16(nibbles, 8));
+}
+
+inline int DecodeSSE2(Byte* output, const char* input, int length)
+{
+	int i = 0;
+	for( ; i + 16 <= length; i += 16 )
+	{
+		__m128i valid = _mm_set1_epi8(-1);
+		const __m128i a = NibblesSSE2(_mm_loadu_si128((const __m128i*)(input + i * 2)), valid);
+		const __m128i b = NibblesSSE2(_mm_loadu_si128((const __m128i*)(input + i * 2 + 16)), valid);
+		if( _mm_movemask_epi8(valid) != 0xFFFF )
+			break;
+		_mm_storeu_si128((__m128i*)(output + i), _mm_packus_epi16(JoinSSE2(a), JoinSSE2(b)));
+	}
+	return i;
+}
+
+PHANTASMA_TARGET_AVX2 inline __m256i DigitsAVX2(__m256i nibbles, __m256i letterOffset)
+{
+	const __m256i letters = _mm256_cmpgt_epi8(nibbles, _mm256_set1_epi8(9));
+	return _mm256_add_epi8(_mm256_add_epi8(nibbles, _mm256_set1_epi8('0')), _mm256_and_si256(letters, letterOffset));
+}
+
+PHANTASMA_TARGET_AVX2 inline int EncodeAVX2(char* output, const Byte* input, int length, bool lowercase)
+{
+	const __m256i letterOffset = _mm256_set1_epi8(lowercase ? 'a' - '0' - 10 : 'A' - '0' - 10);
+	const __m256i mask = _mm256_set1_epi8(0x0F);
+	int i = 0;
+	for( ; i + 32 <= length; i += 32 )
+	{
+		const __m256i in = _mm256_loadu_si256((const __m256i*)(input + i));
+		const __m256i hi = DigitsAVX2(_mm256_and_si256(_mm256_srli_epi16(in, 4), mask), letterOffset);
+		const __m256i lo = DigitsAVX2(_mm256_and_si256(in, mask), letterOffset);
+		// Interleaving works within 128-bit lanes: a holds bytes 0-7 and 16-23, b holds 8-15 and 24-31
+		const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+		const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+		_mm256_storeu_si256((__m256i*)(output + i * 2), _mm256_permute2x128_si256(a, b, 0x20));
+		_mm256_storeu_si256((__m256i*)(output + i * 2 + 32), _mm256_permute2x128_si256(a, b, 0x31));
+	}
+	return i;
+}
+
+PHANTASMA_TARGET_AVX2 inline __m256i NibblesAVX2(__m256i chars, __m256i& valid)
+{
+	const __m256i digit = _mm256_sub_epi8(chars, _mm256_set1_epi8('0'));
+	const __m256i letter = _mm256_sub_epi8(_mm256_or_si256(chars, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+	const __m256i isDigit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+	const __m256i isLetter = _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+	valid = _mm256_and_si256(valid, _mm256_or_si256(isDigit, isLetter));
+	return _mm256_or_si256(_mm256_and_si256(isDigit, digit), _mm256_and_si256(isLetter, _mm256_add_epi8(letter, _mm256_set1_epi8(10))));
+}
+
+PHANTASMA_TARGET_AVX2 inline __m256i JoinAVX2(__m256i nibbles)
+{
+	const __m256i hi = _mm256_slli_epi16(_mm256_and_si256(nibbles, _mm256_set1_epi16(0x00FF)), 4);
+	return _mm256_or_si256(hi, _mm256_srli_epi16(nibbles, 8));
+}
+
+PHANTASMA_TARGET_AVX2 inline int DecodeAVX2(Byte* output, const char* input, int length)
+{
+	int i = 0;
+	for( ; i + 32 <= length; i += 32 )
+	{
+		__m256i valid = _mm256_set1_epi8(-1);
+		const __m256i a = NibblesAVX2(_mm256_loadu_si256((const __m256i*)(input + i * 2)), valid);
+		const __m256i b = NibblesAVX2(_mm256_loadu_si256((const __m256i*)(input + i * 2 + 32)), valid);
+		if( _mm256_movemask_epi8(valid) != -1 )
+			break;
+		// Packing also works within lanes, leaving the 64-bit quarters in the order a0 b0 a1 b1
+		const __m256i packed = _mm256_packus_epi16(JoinAVX2(a), JoinAVX2(b));
+		_mm256_storeu_si256((__m256i*)(output + i), _mm256_permute4x64_epi64(packed, 0xD8));
+	}
+	return i;
+}
+#endif
+
+#if defined(PHANTASMA_SIMD_NEON)
+inline int EncodeNEON(char* output, const Byte* input, int length, bool lowercase)
+{
+	const uint8x16_t alphabet = vld1q_u8((const uint8_t*)(lowercase ? "0123456789abcdef" : "0123456789ABCDEF"));
+	int i = 0;
+	for( ; i + 16 <= length; i += 16 )
+	{
+		const uint8x16_t in = vld1q_u8(input + i);
+		uint8x16x2_t digits;
+		digits.val[0] = vqtbl1q_u8(alphabet, vshrq_n_u8(in, 4));
+		digits.val[1] = vqtbl1q_u8(alphabet, vandq_u8(in, vdupq_n_u8(0x0F)));
+		vst2q_u8((uint8_t*)output + i * 2, digits);
+	}
+	return i;
+}
+
+inline uint8x16_t NibblesNEON(uint8x16_t chars, uint8x16_t& valid)
+{
+	const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+	const uint8x16_t letter = vsubq_u8(vorrq_u8(chars, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+	const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+	const uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+	valid = vandq_u8(valid, vorrq_u8(isDigit, isLetter));
+	return vorrq_u8(vandq_u8(isDigit, digit), vandq_u8(isLetter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+
+inline int DecodeNEON(Byte* output, const char* input, int length)
+{
+	int i = 0;
+	for( ; i + 16 <= length; i += 16 )
+	{
+		// Splits the even (high nibble) and odd (low nibble) digits
+		const uint8x16x2_t chars = vld2q_u8((const uint8_t*)input + i * 2);
+		uint8x16_t valid = vdupq_n_u8(0xFF);
+		const uint8x16_t hi = NibblesNEON(chars.val[0], valid);
+		const uint8x16_t lo = NibblesNEON(chars.val[1], valid);
+		if( vminvq_u8(valid) != 0xFF )
+			break;
+		vst1q_u8(output + i, vorrq_u8(vshlq_n_u8(hi, 4), lo));
+	}
+	return i;
+}
+#endif
+
+inline int EncodeBlocks(Char* output, const Byte* input, int length, bool lowercase)
+{
+	if constexpr( sizeof(Char) != 1 )
+		return 0;
+	char* out = (char*)output;
+	switch( Cpu::ActiveIsa() )
+	{
+#if defined(PHANTASMA_SIMD_X86)
+	case Cpu::Isa::AVX2:
+	{
+		const int done = EncodeAVX2(out, input, length, lowercase);
+		return done + EncodeSSE2(out + done * 2, input + done, length - done, lowercase);
+	}
+	case Cpu::Isa::SSE2:
+		return EncodeSSE2(out, input, length, lowercase);
+#endif
+#if defined(PHANTASMA_SIMD_NEON)
+	case Cpu::Isa::NEON:
+		return EncodeNEON(out, input, length, lowercase);
+#endif
+	default:
+		(void)out;
+		return 0;
+	}
+}
+
+inline int DecodeBlocks(Byte* output, const Char* input, int length)
+{
+	if constexpr( sizeof(Char) != 1 )
+		return 0;
+	const char* in = (const char*)input;
+	switch( Cpu::ActiveIsa() )
+	{
+#if defined(PHANTASMA_SIMD_X86)
+	case Cpu::Isa::AVX2:
+	{
+		const int done = DecodeAVX2(output, in, length);
+		return done + DecodeSSE2(output + done, in + done * 2, length - done);
+	}
+	case Cpu::Isa::SSE2:
+		return DecodeSSE2(output, in, length);
+#endif
+#if defined(PHANTASMA_SIMD_NEON)
+	case Cpu::Isa::NEON:
+		return DecodeNEON(output, in, length);
+#endif
+	default:
+		(void)in;
+		return 0;
+	}
+}
+
+} // namespace Kernels
+
 inline int RequiredCharacters(int numBytes) //does not include a null terminator
 {
 	return numBytes * 2;
@@ -60,7 +315,7 @@ inline bool IsValid(const Char* sz, int inputLength = 0)
 
 	if( lengthDown != length )
 	{
-		int B = AlphabetIndexOf(toupper(sz[0]));
+		int B = NibbleOf(sz[0]);
 		if( B < 0 )
 		{
 			PHANTASMA_EXCEPTION("invalid character");
@@ -69,16 +324,19 @@ inline bool IsValid(const Char* sz, int inputLength = 0)
 		sz++;
 	}
 
-	for( int i = 0; i < lengthDown; i++ )
+	// Validates by decoding into a small scratch block
+	Byte scratch[256];
+	for( int i = 0; i < lengthDown; )
 	{
-		int A = AlphabetIndexOf(toupper(sz[i * 2 + 0]));
-		int B = AlphabetIndexOf(toupper(sz[i * 2 + 1]));
-
-		if( A < 0 || B < 0 )
+		const int block = PHANTASMA_MIN(lengthDown - i, (int)sizeof(scratch));
+		int done = Kernels::DecodeBlocks(scratch, sz + i * 2, block);
+		done += Kernels::DecodeScalar(scratch + done, sz + (i + done) * 2, block - done);
+		if( done != block )
 		{
 			PHANTASMA_EXCEPTION("invalid character");
 			return false;
 		}
+		i += block;
 	}
 
 	return true;
@@ -135,7 +393,7 @@ inline int Decode(Byte* output, int outputLength, const Char* sz, int inputLengt
 		length = PHANTASMA_MIN(length, outputLength);
 		lengthDown = length - 1;
 
-		int B = AlphabetIndexOf(toupper(sz[0]));
+		int B = NibbleOf(sz[0]);
 		if( B < 0 )
 		{
 			PHANTASMA_EXCEPTION("invalid character");
@@ -151,18 +409,12 @@ inline int Decode(Byte* output, int outputLength, const Char* sz, int inputLengt
 		lengthDown = length = PHANTASMA_MIN(length, outputLength);
 	}
 
-	for( int i = 0; i < lengthDown; i++ )
+	int decoded = Kernels::DecodeBlocks(output, sz, lengthDown);
+	decoded += Kernels::DecodeScalar(output + decoded, sz + decoded * 2, lengthDown - decoded);
+	if( decoded != lengthDown )
 	{
-		int A = AlphabetIndexOf(toupper(sz[i * 2 + 0]));
-		int B = AlphabetIndexOf(toupper(sz[i * 2 + 1]));
-
-		if( A < 0 || B < 0 )
-		{
-			PHANTASMA_EXCEPTION("invalid character");
-			return i;
-		}
-
-		output[i] = (Byte)(A * 16 + B);
+		PHANTASMA_EXCEPTION("invalid character");
+		return decoded;
 	}
 
 	return length;
@@ -197,25 +449,14 @@ inline String Encode(const Byte* input, int length, bool lowercase = false)
 		return String();
 	}
 
-	PHANTASMA_VECTOR<Char> c;
-	c.resize(length * 2 + 1);
-	int b;
-	for( int i = 0; i < length; i++ )
-	{
-		b = input[i] >> 4;
-		c[i * 2] = (Char)(55 + b + (((b - 10) >> 31) & -7));
-		b = input[i] & 0xF;
-		c[i * 2 + 1] = (Char)(55 + b + (((b - 10) >> 31) & -7));
-	}
-	c[c.size() - 1] = '\0';
-
-	if( lowercase )
-	{
-		for( Char* i = &c.front(); *i != '\0'; ++i )
-			*i = tolower(*i);
-	}
-
-	return String(&c.front());
+	// PHANTASMA_STRING is only required to be constructible from a zero terminated string
+	PHANTASMA_VECTOR<Char> buffer;
+	buffer.resize(RequiredCharacters(length) + 1);
+	Char* output = &buffer.front();
+	const int done = Kernels::EncodeBlocks(output, input, length, lowercase);
+	Kernels::EncodeScalar(output + done * 2, input + done, length - done, lowercase);
+	buffer[buffer.size() - 1] = '\0';
+	return String(output);
 }
 
 inline String Encode(const ByteArray& input)
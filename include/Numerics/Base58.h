@@ -1,5 +1,4 @@
 #pragma once
-#include "BigInteger.h"
 #include "../Security/SecureByteArray.h"
 #include "../Security/SecureString.h"
 #include "../Utils/ByteArrayUtils.h"
@@ -11,10 +10,246 @@ namespace Base58 {
 constexpr Char Alphabet[] = PHANTASMA_LITERAL("123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz");
 inline int AlphabetIndexOf(Char in)
 {
-	for( const Char* c = Alphabet; *c; ++c )
-		if( *c == in )
-			return (int)(c - Alphabet);
-	return -1;
+	static constexpr signed char Indices[128] = {
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+		-1, 0, 1, 2, 3, 4, 5, 6, 7, 8, -1, -1, -1, -1, -1, -1,
+		-1, 9, 10, 11, 12, 13, 14, 15, 16, -1, 17, 18, 19, 20, 21, -1,
+		22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, -1, -1, -1, -1, -1,
+		-1, 33, 34, 35, 36, 37, 38, 39, 40, 41, 42, 43, -1, 44, 45, 46,
+		47, 48, 49, 50, 51, 52, 53, 54, 55, 56, 57, -1, -1, -1, -1, -1
+	};
+	return (UInt32)in < 128 ? Indices[(UInt32)in] : -1;
+}
+
+// Upper bound of the encoded length of `bytes` input bytes, including the digit written for a zero value
+constexpr int EncodedLengthBound(int bytes)
+{
+	return bytes * 138 / 100 + 2;
+}
+
+// Upper bound of the decoded length of `chars` input characters
+constexpr int DecodedLengthBound(int chars)
+{
+	return chars * 733 / 1000 + 1;
+}
+
+// The codec works on the value as little-endian 32-bit limbs, five base 58 digits at a time
+namespace Limbs {
+
+// 58^5, the largest power of 58 that fits in a limb
+constexpr UInt32 Radix5 = 656356768u;
+constexpr UInt32 Pow58[6] = { 1, 58, 3364, 195112, 11316496, Radix5 };
+
+constexpr int LimbsForBytes(int bytes)
+{
+	return (bytes + 3) / 4;
+}
+
+constexpr int LimbsForChars(int chars)
+{
+	return LimbsForBytes(DecodedLengthBound(chars)) + 1;
+}
+
+// Loads big-endian bytes and returns the limb count without leading zero limbs
+inline int Load(UInt32* limbs, const Byte* input, int length)
+{
+	int n = 0;
+	for( int end = length; end > 0; end -= 4 )
+	{
+		UInt32 limb = 0;
+		for( int i = end > 4 ? end - 4 : 0; i < end; ++i )
+			limb = (limb << 8) | input[i];
+		limbs[n++] = limb;
+	}
+	while( n > 0 && limbs[n - 1] == 0 )
+		--n;
+	return n;
+}
+
+// Divides in place by 58^5, dropping the top limb once it reaches zero, and returns the remainder
+inline UInt32 DivRadix5(UInt32* limbs, int& n)
+{
+	UInt64 rem = 0;
+	for( int i = n - 1; i >= 0; --i )
+	{
+		const UInt64 cur = (rem << 32) | limbs[i];
+		limbs[i] = (UInt32)(cur / Radix5);
+		rem = cur % Radix5;
+	}
+	while( n > 0 && limbs[n - 1] == 0 )
+		--n;
+	return (UInt32)rem;
+}
+
+// limbs = limbs * m + a
+inline void MulAdd(UInt32* limbs, int& n, UInt32 m, UInt32 a)
+{
+	UInt64 carry = a;
+	for( int i = 0; i < n; ++i )
+	{
+		const UInt64 cur = (UInt64)limbs[i] * m + carry;
+		limbs[i] = (UInt32)cur;
+		carry = cur >> 32;
+	}
+	if( carry )
+		limbs[n++] = (UInt32)carry;
+}
+
+inline int ByteLength(const UInt32* limbs, int n)
+{
+	if( n == 0 )
+		return 0;
+	const UInt32 top = limbs[n - 1];
+	return (n - 1) * 4 + (top >> 24 ? 4 : top >> 16 ? 3 : top >> 8 ? 2 : 1);
+}
+
+// Writes the first `count` bytes of the value as a `length` byte big-endian number
+inline void Store(Byte* output, int count, int length, const UInt32* limbs, int n)
+{
+	for( int i = 0; i < count; ++i )
+	{
+		const int byte = length - 1 - i;
+		output[i] = byte / 4 < n ? (Byte)(limbs[byte / 4] >> ((byte % 4) * 8)) : 0;
+	}
+}
+
+// Writes the encoding of input to output, which must hold EncodedLengthBound(length) characters, and returns its
+// length. limbs must hold LimbsForBytes(length) entries. Like the reference implementation, a zero value is written as
+// one zero digit after the digits for the leading zero bytes.
+inline int Encode(Char* output, const Byte* input, int length, UInt32* limbs)
+{
+	int leadingZeros = 0;
+	while( leadingZeros < length && input[leadingZeros] == 0 )
+		++leadingZeros;
+
+	int n = Load(limbs, input + leadingZeros, length - leadingZeros);
+	Char* const end = output + EncodedLengthBound(length);
+	Char* p = end;
+	while( n > 0 )
+	{
+		UInt32 rem = DivRadix5(limbs, n);
+		if( n > 0 )
+		{
+			for( int k = 0; k < 5; ++k )
+			{
+				*--p = Alphabet[rem % 58];
+				rem /= 58;
+			}
+		}
+		else
+		{
+			for( ; rem; rem /= 58 )
+				*--p = Alphabet[rem % 58];
+		}
+	}
+	if( p == end )
+		*--p = Alphabet[0];
+	for( int i = 0; i < leadingZeros; ++i )
+		*--p = Alphabet[0];
+
+	const int count = (int)(end - p);
+	memmove(output, p, count * sizeof(Char));
+	return count;
+}
+
+// Parses input into limbs, which must hold LimbsForChars(inputLength) entries. Returns the number of leading zero
+// digits, or -1 on a character outside the alphabet.
+inline int Decode(UInt32* limbs, int& n, const Char* input, int inputLength)
+{
+	n = 0;
+	int leadingZeros = 0;
+	while( leadingZeros < inputLength && input[leadingZeros] == Alphabet[0] )
+		++leadingZeros;
+
+	for( int i = leadingZeros; i < inputLength; )
+	{
+		const int chunk = PHANTASMA_MIN(5, inputLength - i);
+		UInt32 value = 0;
+		for( int k = 0; k < chunk; ++k, ++i )
+		{
+			const int digit = AlphabetIndexOf(input[i]);
+			if( digit < 0 )
+				return -1;
+			value = value * 58 + (UInt32)digit;
+		}
+		MulAdd(limbs, n, Pow58[chunk], value);
+	}
+	return leadingZeros;
+}
+
+// Stack storage for the common sizes, heap storage beyond them. Wiped on release, as the secure variants use it too.
+template<class T, int InlineCount>
+class Scratch
+{
+  public:
+	explicit Scratch(int count) : _data(_inline), _count(count)
+	{
+		if( count > InlineCount )
+		{
+			_heap.resize(count);
+			_data = &_heap.front();
+		}
+	}
+	~Scratch() { PHANTASMA_WIPEMEM(_data, _count * sizeof(T)); }
+	Scratch(const Scratch&) = delete;
+	Scratch& operator=(const Scratch&) = delete;
+
+	T* Data() { return _data; }
+
+  private:
+	T _inline[InlineCount];
+	PHANTASMA_VECTOR<T> _heap;
+	T* _data;
+	int _count;
+};
+
+typedef Scratch<UInt32, 64> LimbScratch;
+typedef Scratch<Char, 360> CharScratch;
+typedef Scratch<Byte, 256> ByteScratch;
+
+} // namespace Limbs
+
+// Encodes exactly Length bytes into output, which must hold EncodedLengthBound(Length) characters, without touching
+// the heap. Returns the encoded length.
+template<int Length>
+int EncodeFixed(Char* output, const Byte* input)
+{
+	UInt32 limbs[Limbs::LimbsForBytes(Length)];
+	return Limbs::Encode(output, input, Length, limbs);
+}
+
+// Decodes input into exactly Length bytes without touching the heap. Returns the decoded length as Decode would, so
+// any result other than Length means the text does not hold a Length byte value and output was left untouched.
+// A character outside the alphabet sets *out_error when given, instead of raising an exception.
+template<int Length>
+int DecodeFixed(Byte* output, const Char* input, int inputLength, bool* out_error = 0)
+{
+	constexpr int maxChars = EncodedLengthBound(Length);
+	if( !input || inputLength < 0 )
+	{
+		PHANTASMA_EXCEPTION("Invalid usage");
+		return -1;
+	}
+	if( inputLength > maxChars )
+		return -1;
+
+	UInt32 limbs[Limbs::LimbsForChars(maxChars)];
+	int n;
+	const int leadingZeros = Limbs::Decode(limbs, n, input, inputLength);
+	if( leadingZeros < 0 )
+	{
+		if( out_error )
+			*out_error = true;
+		else
+			PHANTASMA_EXCEPTION("invalid character");
+		return -1;
+	}
+	const int length = leadingZeros + Limbs::ByteLength(limbs, n);
+	if( length == Length )
+		Limbs::Store(output, Length, Length, limbs, n);
+	return length;
 }
 
 inline int Decode(Byte* output, int outputLength, const Char* input, int inputLength)
@@ -31,27 +266,17 @@ inline int Decode(Byte* output, int outputLength, const Char* input, int inputLe
 			return 0;
 	}
 
-	BigInteger bi = BigInteger::Zero();
-	for( int i = inputLength - 1; i >= 0; i-- )
-	{
-		int index = AlphabetIndexOf(input[i]);
-		if( index < 0 )
-		{
-			PHANTASMA_EXCEPTION("invalid character");
-			return -1;
-		}
-
-		bi += BigInteger(index) * BigInteger::Pow(58, inputLength - 1 - i);
-	}
-
-	int leadingZeros = 0;
-	for( int i = 0; i < inputLength && input[i] == Alphabet[0]; i++ )
+	Limbs::LimbScratch limbs(Limbs::LimbsForChars(inputLength));
+	int n;
+	const int leadingZeros = Limbs::Decode(limbs.Data(), n, input, inputLength);
+	if( leadingZeros < 0 )
 	{
-		leadingZeros++;
+		PHANTASMA_EXCEPTION("invalid character");
+		return -1;
 	}
 
-	int bigIntBytes = bi.ToUnsignedByteArray(0, 0);
-	int bytesRequired = bigIntBytes + leadingZeros;
+	const int valueBytes = Limbs::ByteLength(limbs.Data(), n);
+	const int bytesRequired = valueBytes + leadingZeros;
 	if( !output )
 		return bytesRequired;
 	if( bytesRequired > outputLength )
@@ -59,9 +284,7 @@ inline int Decode(Byte* output, int outputLength, const Char* input, int inputLe
 
 	for( int i = 0; i < leadingZeros; ++i )
 		output[i] = 0;
-
-	bi.ToUnsignedByteArray(output + leadingZeros, outputLength - leadingZeros);
-	ArrayReverse(output + leadingZeros, bigIntBytes);
+	Limbs::Store(output + leadingZeros, valueBytes, valueBytes, limbs.Data(), n);
 	return bytesRequired;
 }
 
@@ -73,30 +296,19 @@ inline ByteArray Decode(const String& input)
 		return tmp;
 	}
 
-	BigInteger bi = BigInteger::Zero();
-	for( int i = (int)input.length() - 1; i >= 0; i-- )
+	const int inputLength = (int)input.length();
+	Limbs::LimbScratch limbs(Limbs::LimbsForChars(inputLength));
+	int n;
+	const int leadingZeros = Limbs::Decode(limbs.Data(), n, input.c_str(), inputLength);
+	if( leadingZeros < 0 )
 	{
-		int index = AlphabetIndexOf(input[i]);
-		if( index < 0 )
-		{
-			PHANTASMA_EXCEPTION("invalid character");
-			return tmp;
-		}
-
-		bi += BigInteger(index) * BigInteger::Pow(58, (int)input.length() - 1 - i);
-	}
-
-	ByteArray bytes = bi.ToUnsignedByteArray();
-	ArrayReverse(bytes);
-
-	int leadingZeros = 0;
-	for( int i = 0; i < (int)input.length() && input[i] == Alphabet[0]; i++ )
-	{
-		leadingZeros++;
+		PHANTASMA_EXCEPTION("invalid character");
+		return tmp;
 	}
 
-	tmp.resize(bytes.size() + leadingZeros);
-	PHANTASMA_COPY(bytes.begin(), bytes.end(), tmp.begin() + leadingZeros);
+	const int valueBytes = Limbs::ByteLength(limbs.Data(), n);
+	tmp.resize(valueBytes + leadingZeros);
+	Limbs::Store(&tmp.front() + leadingZeros, valueBytes, valueBytes, limbs.Data(), n);
 	return tmp;
 }
 
@@ -135,42 +347,25 @@ inline int DecodeSecure(Byte* output, int outputSize, const Char* input, int inp
 	if( !input || input[0] == '\0' )
 		return 0;
 
-	SecureBigInteger bi = SecureBigInteger::Zero();
-	for( int i = inputLength - 1; i >= 0; i-- )
+	Limbs::LimbScratch limbs(Limbs::LimbsForChars(inputLength));
+	int n;
+	const int leadingZeros = Limbs::Decode(limbs.Data(), n, input, inputLength);
+	if( leadingZeros < 0 )
 	{
-		int index = AlphabetIndexOf(input[i]);
-		if( index < 0 )
-		{
-			PHANTASMA_EXCEPTION("invalid character");
-			return 0;
-		}
-
-		bi += SecureBigInteger(index) * SecureBigInteger::Pow(58, inputLength - 1 - i);
+		PHANTASMA_EXCEPTION("invalid character");
+		return 0;
 	}
 
-	int numBytes = bi.ToUnsignedByteArray(0, 0);
-	SecureByteArray byteAllocation(numBytes, 0, false);
-	const auto& byteWriter = byteAllocation.Write();
-	Byte* bytes = byteWriter.Bytes();
-
-	bi.ToUnsignedByteArray(bytes, numBytes);
-
-	ArrayReverse(bytes, numBytes);
-
-	int leadingZeros = 0;
-	for( int i = 0; i < inputLength && input[i] == Alphabet[0]; i++ )
-	{
-		if( leadingZeros < outputSize )
-			output[leadingZeros] = 0;
-		leadingZeros++;
-	}
+	const int numBytes = Limbs::ByteLength(limbs.Data(), n);
+	for( int i = 0; i < leadingZeros && i < outputSize; ++i )
+		output[i] = 0;
 
 	int resultSize = numBytes + leadingZeros;
 
 	int canWrite = PHANTASMA_MIN(outputSize - leadingZeros, numBytes);
 	if( canWrite > 0 )
 	{
-		PHANTASMA_COPY(bytes, bytes + canWrite, output + leadingZeros);
+		Limbs::Store(output + leadingZeros, canWrite, numBytes, limbs.Data(), n);
 	}
 
 	return resultSize;
@@ -219,54 +414,29 @@ inline int CheckDecodeSecure(Byte* output, int outputSize, const Char* input, in
 	return resultSize;
 }
 
-template<class String, class ByteArray, class BigInteger, class CharArray>
+template<class String>
 String TEncode(const Byte* input, int length)
 {
 	if( length <= 0 )
 		return String();
 
-	ByteArray temp;
-	temp.resize(length + 1);
-	for( int i = 0; i < length; i++ )
-	{
-		temp[i] = input[(length - 1) - i];
-	}
-	temp[length] = 0;
-
-	BigInteger value(temp);
-	CharArray sb;
-	sb.reserve(length);
-	while( value >= 58 )
-	{
-		BigInteger mod = value % 58;
-		sb.push_back(Alphabet[(int)mod]);
-		value /= 58;
-	}
-	sb.push_back(Alphabet[(int)value]);
-
-	for( int i = 0; i < length; ++i )
-	{
-		if( input[i] == 0 )
-			sb.push_back(Alphabet[0]);
-		else
-			break;
-	}
-	ArrayReverse(sb);
-
-	return String{ &sb.front(), (typename String::size_type)sb.size() };
+	Limbs::LimbScratch limbs(Limbs::LimbsForBytes(length));
+	Limbs::CharScratch chars(EncodedLengthBound(length));
+	const int count = Limbs::Encode(chars.Data(), input, length, limbs.Data());
+	return String{ chars.Data(), (typename String::size_type)count };
 }
 
 inline String Encode(const Byte* input, int length)
 {
-	return TEncode<String, ByteArray, BigInteger, PHANTASMA_VECTOR<Char>>(input, length);
+	return TEncode<String>(input, length);
 }
 
 inline SecureString EncodeSecure(const Byte* input, int length)
 {
-	return TEncode<SecureString, SecureVector<Byte>, SecureBigInteger, SecureVector<Char>>(input, length);
+	return TEncode<SecureString>(input, length);
 }
 
-template<class String, class ByteArray, class BigInteger, class CharArray>
+template<class String>
 String TCheckEncode(const Byte* input, int length)
 {
 	if( length <= 0 )
@@ -276,21 +446,20 @@ String TCheckEncode(const Byte* input, int length)
 	SHA256(checksum1, PHANTASMA_SHA256_LENGTH, input, length);
 	SHA256(checksum2, PHANTASMA_SHA256_LENGTH, checksum1, PHANTASMA_SHA256_LENGTH);
 
-	ByteArray buffer;
-	buffer.resize(length + 4);
-	PHANTASMA_COPY(input, input + length, &buffer[0]);
-	PHANTASMA_COPY(checksum2, checksum2 + 4, &buffer[length]);
+	Limbs::ByteScratch buffer(length + 4);
+	PHANTASMA_COPY(input, input + length, buffer.Data());
+	PHANTASMA_COPY(checksum2, checksum2 + 4, buffer.Data() + length);
 
-	return TEncode<String, ByteArray, BigInteger, CharArray>(&buffer.front(), (int)buffer.size());
+	return TEncode<String>(buffer.Data(), length + 4);
 }
 
 inline String CheckEncode(const Byte* input, int length)
 {
-	return TCheckEncode<String, ByteArray, BigInteger, PHANTASMA_VECTOR<Char>>(input, length);
+	return TCheckEncode<String>(input, length);
 }
 inline SecureString CheckEncodeSecure(const Byte* input, int length)
 {
-	return TCheckEncode<SecureString, SecureVector<Byte>, SecureBigInteger, SecureVector<Char>>(input, length);
+	return TCheckEncode<SecureString>(input, length);
 }
 
 } // namespace Base58
@@ -4,6 +4,8 @@
 #endif
 
 #include <ctype.h>
+#include <string>
+#include "../Utils/CpuFeatures.h"
 
 namespace phantasma {
 namespace Base64 {
@@ -18,12 +20,255 @@ inline int AlphabetIndexOf(Char in)
 	return -1;
 }
 
+// Alphabet index of every 8-bit character, -1 for characters outside the alphabet
+struct DecodeTable {
+	signed char values[256];
+	constexpr DecodeTable() : values()
+	{
+		for( int i = 0; i != 256; ++i )
+			values[i] = -1;
+		for( int i = 0; i != 64; ++i )
+			values[(int)Alphabet[i]] = (signed char)i;
+	}
+	int operator[](Char in) const { return (UInt32)in < 256 ? values[(UInt32)in] : -1; }
+};
+constexpr DecodeTable Indices;
+
 constexpr inline int RequiredCharacters(int numBytes) //does not include a null terminator
 {
 	int numTriBytes = (numBytes + 2) / 3;
 	return numTriBytes * 4;
 }
 
+// Bulk conversion of whole blocks. Encoding consumes a multiple of 3 bytes and decoding a multiple of 4 characters;
+// each function returns how much input it consumed and leaves the rest, including any block that holds padding or an
+// invalid character, to the caller.
+namespace Kernels {
+
+inline int EncodeScalar(Char* output, const Byte* input, int length)
+{
+	int i = 0;
+	for( ; i + 3 <= length; i += 3 )
+	{
+		const UInt32 triByte = ((UInt32)input[i] << 16) | ((UInt32)input[i + 1] << 8) | input[i + 2];
+		*output++ = Alphabet[(triByte >> 3 * 6) & 0x3F];
+		*output++ = Alphabet[(triByte >> 2 * 6) & 0x3F];
+		*output++ = Alphabet[(triByte >> 1 * 6) & 0x3F];
+		*output++ = Alphabet[(triByte >> 0 * 6) & 0x3F];
+	}
+	return i;
+}
+
+inline int DecodeScalar(Byte* output, const Char* input, int length)
+{
+	int i = 0;
+	for( ; i + 4 <= length; i += 4 )
+	{
+		const int a = Indices[input[i]];
+		const int b = Indices[input[i + 1]];
+		const int c = Indices[input[i + 2]];
+		const int d = Indices[input[i + 3]];
+		if( (a | b | c | d) < 0 )
+			break;
+		const UInt32 triByte = ((UInt32)a << 18) | ((UInt32)b << 12) | ((UInt32)c << 6) | (UInt32)d;
+		*output++ = (Byte)(triByte >> 16);
+		*output++ = (Byte)(triByte >> 8);
+		*output++ = (Byte)triByte;
+	}
+	return i;
+}
+
+#if defined(PHANTASMA_SIMD_X86)
+// 24 bytes per step, read as two overlapping 16-byte loads, so 4 bytes past the block must be readable
+PHANTASMA_TARGET_AVX2 inline int EncodeAVX2(char* output, const Byte* input, int length)
+{
+	const __m256i reshuffle = _mm256_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10, 1, 0, 2, 1, 4, 3, 5, 4, 7,
+	    6, 8, 7, 10, 9, 11, 10);
+	const __m256i shiftLut = _mm256_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+	    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0, 'a' - 26, '0' - 52, '0' - 52, '0' - 52,
+	    '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+	int i = 0;
+	for( ; i + 28 <= length; i += 24 )
+	{
+		const __m128i first = _mm_loadu_si128((const __m128i*)(input + i));
+		const __m128i second = _mm_loadu_si128((const __m128i*)(input + i + 12));
+		const __m256i in = _mm256_inserti128_si256(_mm256_castsi128_si256(first), second, 1);
+		// Each 32-bit lane holds one group of 3 bytes as b1 b0 b2 b1; split it into four 6-bit indices
+		const __m256i groups = _mm256_shuffle_epi8(in, reshuffle);
+		const __m256i ac = _mm256_mulhi_epu16(_mm256_and_si256(groups, _mm256_set1_epi32(0x0FC0FC00)), _mm256_set1_epi32(0x04000040));
+		const __m256i bd = _mm256_mullo_epi16(_mm256_and_si256(groups, _mm256_set1_epi32(0x003F03F0)), _mm256_set1_epi32(0x01000010));
+		const __m256i indices = _mm256_or_si256(ac, bd);
+		// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12, then add the offset for that range
+		__m256i range = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+		const __m256i upper = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+		range = _mm256_or_si256(range, _mm256_and_si256(upper, _mm256_set1_epi8(13)));
+		const __m256i chars = _mm256_add_epi8(_mm256_shuffle_epi8(shiftLut, range), indices);
+		_mm256_storeu_si256((__m256i*)(output + i / 3 * 4), chars);
+	}
+	return i;
+}
+
+// 32 characters to 24 bytes per step
+PHANTASMA_TARGET_AVX2 inline int DecodeAVX2(Byte* output, const char* input, int length)
+{
+	// A character is valid when the classes of its low and high nibbles do not overlap
+	const __m256i lutLo = _mm256_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B,
+	    0x1B, 0x1B, 0x1A, 0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+	const __m256i lutHi = _mm256_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10,
+	    0x10, 0x10, 0x10, 0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+	// Offset from the character to its index, by high nibble ('/' is moved to slot 1)
+	const __m256i lutRoll = _mm256_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 19, 4, -65,
+	    -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+	const __m256i nibble = _mm256_set1_epi8(0x0F);
+	const __m256i pack = _mm256_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1, 0, 6, 5, 4, 10, 9,
+	    8, 14, 13, 12, -1, -1, -1, -1);
+	int i = 0;
+	for( ; i + 32 <= length; i += 32 )
+	{
+		const __m256i in = _mm256_loadu_si256((const __m256i*)(input + i));
+		const __m256i hi = _mm256_and_si256(_mm256_srli_epi32(in, 4), nibble);
+		const __m256i lo = _mm256_and_si256(in, nibble);
+		if( !_mm256_testz_si256(_mm256_shuffle_epi8(lutLo, lo), _mm256_shuffle_epi8(lutHi, hi)) )
+			break;
+		const __m256i slash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8('/'));
+		const __m256i indices = _mm256_add_epi8(in, _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(slash, hi)));
+		// Join the four 6-bit indices of each 32-bit lane into 3 bytes, then gather the 12 bytes of each half
+		const __m256i pairs = _mm256_maddubs_epi16(indices, _mm256_set1_epi32(0x01400140));
+		const __m256i triBytes = _mm256_madd_epi16(pairs, _mm256_set1_epi32(0x00011000));
+		const __m256i bytes = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(triBytes, pack), _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+		Byte* out = output + i / 4 * 3;
+		_mm_storeu_si128((__m128i*)out, _mm256_castsi256_si128(bytes));
+		_mm_storel_epi64((__m128i*)(out + 16), _mm256_extracti128_si256(bytes, 1));
+	}
+	return i;
+}
+#endif
+
+#if defined(PHANTASMA_SIMD_NEON)
+// 48 bytes to 64 characters per step
+inline int EncodeNEON(char* output, const Byte* input, int length)
+{
+	uint8x16x4_t alphabet;
+	for( int t = 0; t != 4; ++t )
+		alphabet.val[t] = vld1q_u8((const uint8_t*)"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/" + t * 16);
+	const uint8x16_t six = vdupq_n_u8(0x3F);
+	int i = 0;
+	for( ; i + 48 <= length; i += 48 )
+	{
+		const uint8x16x3_t in = vld3q_u8(input + i);
+		uint8x16x4_t chars;
+		chars.val[0] = vshrq_n_u8(in.val[0], 2);
+		chars.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), six);
+		chars.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), six);
+		chars.val[3] = vandq_u8(in.val[2], six);
+		for( int t = 0; t != 4; ++t )
+			chars.val[t] = vqtbl4q_u8(alphabet, chars.val[t]);
+		vst4q_u8((uint8_t*)output + i / 3 * 4, chars);
+	}
+	return i;
+}
+
+// Indices of 16 characters, clearing `valid` where a character is outside the alphabet
+inline uint8x16_t IndicesNEON(uint8x16_t chars, uint8x16_t& valid)
+{
+	const uint8x16_t upper = vsubq_u8(chars, vdupq_n_u8('A'));
+	const uint8x16_t lower = vsubq_u8(chars, vdupq_n_u8('a'));
+	const uint8x16_t digit = vsubq_u8(chars, vdupq_n_u8('0'));
+	const uint8x16_t isUpper = vcleq_u8(upper, vdupq_n_u8(25));
+	const uint8x16_t isLower = vcleq_u8(lower, vdupq_n_u8(25));
+	const uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+	const uint8x16_t isPlus = vceqq_u8(chars, vdupq_n_u8('+'));
+	const uint8x16_t isSlash = vceqq_u8(chars, vdupq_n_u8('/'));
+	valid = vandq_u8(valid, vorrq_u8(vorrq_u8(isUpper, isLower), vorrq_u8(isDigit, vorrq_u8(isPlus, isSlash))));
+	uint8x16_t index = vandq_u8(isUpper, upper);
+	index = vorrq_u8(index, vandq_u8(isLower, vaddq_u8(lower, vdupq_n_u8(26))));
+	index = vorrq_u8(index, vandq_u8(isDigit, vaddq_u8(digit, vdupq_n_u8(52))));
+	index = vorrq_u8(index, vandq_u8(isPlus, vdupq_n_u8(62)));
+	return vorrq_u8(index, vandq_u8(isSlash, vdupq_n_u8(63)));
+}
+
+// 64 characters to 48 bytes per step
+inline int DecodeNEON(Byte* output, const char* input, int length)
+{
+	int i = 0;
+	for( ; i + 64 <= length; i += 64 )
+	{
+		const uint8x16x4_t chars = vld4q_u8((const uint8_t*)input + i);
+		uint8x16_t valid = vdupq_n_u8(0xFF);
+		const uint8x16_t a = IndicesNEON(chars.val[0], valid);
+		const uint8x16_t b = IndicesNEON(chars.val[1], valid);
+		const uint8x16_t c = IndicesNEON(chars.val[2], valid);
+		const uint8x16_t d = IndicesNEON(chars.val[3], valid);
+		if( vminvq_u8(valid) != 0xFF )
+			break;
+		uint8x16x3_t bytes;
+		bytes.val[0] = vorrq_u8(vshlq_n_u8(a, 2), vshrq_n_u8(b, 4));
+		bytes.val[1] = vorrq_u8(vshlq_n_u8(b, 4), vshrq_n_u8(c, 2));
+		bytes.val[2] = vorrq_u8(vshlq_n_u8(c, 6), d);
+		vst3q_u8(output + i / 4 * 3, bytes);
+	}
+	return i;
+}
+#endif
+
+inline int EncodeBlocks(Char* output, const Byte* input, int length)
+{
+	if constexpr( sizeof(Char) != 1 )
+		return 0;
+	char* out = (char*)output;
+	switch( Cpu::ActiveIsa() )
+	{
+#if defined(PHANTASMA_SIMD_X86)
+	case Cpu::Isa::AVX2:
+		return EncodeAVX2(out, input, length);
+#endif
+#if defined(PHANTASMA_SIMD_NEON)
+	case Cpu::Isa::NEON:
+		return EncodeNEON(out, input, length);
+#endif
+	default:
+		(void)out;
+		return 0;
+	}
+}
+
+inline int DecodeBlocks(Byte* output, const Char* input, int length)
+{
+	if constexpr( sizeof(Char) != 1 )
+		return 0;
+	const char* in = (const char*)input;
+	switch( Cpu::ActiveIsa() )
+	{
+#if defined(PHANTASMA_SIMD_X86)
+	case Cpu::Isa::AVX2:
+		return DecodeAVX2(output, in, length);
+#endif
+#if defined(PHANTASMA_SIMD_NEON)
+	case Cpu::Isa::NEON:
+		return DecodeNEON(output, in, length);
+#endif
+	default:
+		(void)in;
+		return 0;
+	}
+}
+
+// Encodes the whole 3-byte groups of input, returning the number of bytes consumed
+inline int EncodeGroups(Char* output, const Byte* input, int length)
+{
+	const int done = EncodeBlocks(output, input, length);
+	return done + EncodeScalar(output + done / 3 * 4, input + done, length - done);
+}
+
+// Decodes whole 4-character groups without padding, returning the number of characters consumed
+inline int DecodeGroups(Byte* output, const Char* input, int length)
+{
+	const int done = DecodeBlocks(output, input, length);
+	return done + DecodeScalar(output + done / 4 * 3, input + done, length - done);
+}
+
+} // namespace Kernels
+
 inline int DecodeTriByte(Byte* output, const Char* input) //read 4 Chars, write 1-3 bytes
 {
 	int padding = 0;
@@ -63,10 +308,9 @@ inline int Decode(Byte* output, int outputLength, const Char* input, int inputLe
 	}
 
 	int length, padding;
-	for( length = 0; length < inputLength && input[length] != '='; ++length )
-	{
-	}
-	for( padding = 0; length < inputLength && input[length + padding] == '='; ++padding )
+	const Char* firstPad = std::char_traits<Char>::find(input, inputLength, '=');
+	length = firstPad ? (int)(firstPad - input) : inputLength;
+	for( padding = 0; length + padding < inputLength && input[length + padding] == '='; ++padding )
 	{
 	}
 
@@ -89,7 +333,10 @@ inline int Decode(Byte* output, int outputLength, const Char* input, int inputLe
 		return -1;
 	}
 
-	for( int i = 0, cursor = 0; i < numTriBytes; ++i )
+	// Whole groups in bulk; the group holding the padding, or an invalid character, goes through DecodeTriByte
+	const int bulkChars = padding ? inputLength - 4 : inputLength;
+	const int done = Kernels::DecodeGroups(output, input, bulkChars);
+	for( int i = done / 4, cursor = done / 4 * 3; i < numTriBytes; ++i )
 	{
 		int bytesDecoded = DecodeTriByte(output + cursor, input + i * 4);
 		if( bytesDecoded <= 0 )
@@ -134,8 +381,9 @@ inline int Encode(Char* output, int outputSize, const Byte* input, int inputLeng
 		return -1;
 	}
 
-	Char* out = output;
-	for( int i = 0; i < inputLength; )
+	const int done = Kernels::EncodeGroups(output, input, inputLength);
+	Char* out = output + done / 3 * 4;
+	for( int i = done; i < inputLength; )
 	{
 		UInt32 b0 = input[i++];
 		UInt32 b1 = i < inputLength ? input[i++] : 0;
@@ -163,11 +411,11 @@ inline String Encode(const Byte* input, int length)
 		return String();
 	}
 
-	int requiredBuffer = Encode(0, 0, input, length);
-	PHANTASMA_VECTOR<Char> c;
-	c.resize(requiredBuffer);
-	Encode(&c.front(), requiredBuffer, input, length);
-	return String(&c.front());
+	const int requiredBuffer = Encode(0, 0, input, length);
+	PHANTASMA_VECTOR<Char> buffer;
+	buffer.resize(requiredBuffer);
+	Encode(&buffer.front(), requiredBuffer, input, length);
+	return String(&buffer.front());
 }
 
 inline String Encode(const ByteArray& input)
@@ -175,5 +423,152 @@ inline String Encode(const ByteArray& input)
 	return Encode(input.empty() ? 0 : &input.front(), (int)input.size());
 }
 
+// Encodes a stream given in pieces of any size. Up to 2 bytes are held back between calls to Update; Final writes
+// them with the padding.
+class Encoder
+{
+  public:
+	// Characters Update may write for `length` more bytes
+	static constexpr int MaxUpdateCharacters(int length) { return (length + 2) / 3 * 4; }
+	// Characters Final may write
+	static constexpr int MaxFinalCharacters = 4;
+
+	// Returns the number of characters written
+	int Update(Char* output, const Byte* input, int length)
+	{
+		if( (!input && length > 0) || length < 0 || !output )
+		{
+			PHANTASMA_EXCEPTION("invalid argument");
+			return -1;
+		}
+		Char* out = output;
+		while( _pendingLength != 0 && length > 0 )
+		{
+			_pending[_pendingLength++] = *input++;
+			--length;
+			if( _pendingLength == 3 )
+			{
+				Kernels::EncodeScalar(out, _pending, 3);
+				out += 4;
+				_pendingLength = 0;
+			}
+		}
+		const int done = Kernels::EncodeGroups(out, input, length);
+		out += done / 3 * 4;
+		for( int i = done; i < length; ++i )
+			_pending[_pendingLength++] = input[i];
+		return (int)(out - output);
+	}
+
+	// Writes the held back bytes and padding, returns the number of characters written and resets the encoder
+	int Final(Char* output)
+	{
+		if( !output )
+		{
+			PHANTASMA_EXCEPTION("invalid argument");
+			return -1;
+		}
+		if( _pendingLength == 0 )
+			return 0;
+		const UInt32 triByte = ((UInt32)_pending[0] << 16) | (_pendingLength > 1 ? (UInt32)_pending[1] << 8 : 0);
+		output[0] = Alphabet[(triByte >> 3 * 6) & 0x3F];
+		output[1] = Alphabet[(triByte >> 2 * 6) & 0x3F];
+		output[2] = _pendingLength > 1 ? Alphabet[(triByte >> 1 * 6) & 0x3F] : '=';
+		output[3] = '=';
+		_pendingLength = 0;
+		return 4;
+	}
+
+  private:
+	Byte _pending[3] = {};
+	int _pendingLength = 0;
+};
+
+// Decodes a stream given in pieces of any size. Up to 3 characters are held back between calls to Update. Padding
+// ends the stream; Final reports whether the stream ended on a group boundary.
+class Decoder
+{
+  public:
+	// Bytes Update may write for `length` more characters
+	static constexpr int MaxUpdateBytes(int length) { return (length + 3) / 4 * 3; }
+
+	// Returns the number of bytes written, or -1 on invalid input
+	int Update(Byte* output, const Char* input, int length)
+	{
+		if( (!input && length > 0) || length < 0 || !output )
+		{
+			PHANTASMA_EXCEPTION("invalid argument");
+			return -1;
+		}
+		Byte* out = output;
+		while( length > 0 )
+		{
+			if( _pendingLength == 0 && !_ended )
+			{
+				const int done = Kernels::DecodeGroups(out, input, length);
+				out += done / 4 * 3;
+				input += done;
+				length -= done;
+				if( length == 0 )
+					break;
+			}
+			if( _ended )
+			{
+				PHANTASMA_EXCEPTION("Invalid input");
+				return -1;
+			}
+			_pending[_pendingLength++] = *input++;
+			--length;
+			if( _pendingLength == 4 )
+			{
+				const int decoded = DecodeGroup(out);
+				if( decoded < 0 )
+					return -1;
+				out += decoded;
+			}
+		}
+		return (int)(out - output);
+	}
+
+	// Returns 0 if the stream ended on a group boundary, or -1 if characters are left over. Resets the decoder.
+	int Final()
+	{
+		const bool complete = _pendingLength == 0;
+		_pendingLength = 0;
+		_ended = false;
+		if( !complete )
+		{
+			PHANTASMA_EXCEPTION("Invalid input");
+			return -1;
+		}
+		return 0;
+	}
+
+  private:
+	int DecodeGroup(Byte* output)
+	{
+		_pendingLength = 0;
+		// Padding is only valid as the last one or two characters of a group
+		const int padding = _pending[3] != '=' ? 0 : _pending[2] != '=' ? 1 : 2;
+		if( _pending[0] == '=' || _pending[1] == '=' || (padding == 0 && _pending[2] == '=') )
+		{
+			PHANTASMA_EXCEPTION("Invalid input");
+			return -1;
+		}
+		const int decoded = DecodeTriByte(output, _pending);
+		if( decoded <= 0 )
+		{
+			PHANTASMA_EXCEPTION("Invalid input");
+			return -1;
+		}
+		_ended = padding != 0;
+		return decoded;
+	}
+
+	Char _pending[4] = {};
+	int _pendingLength = 0;
+	bool _ended = false;
+};
+
 } // namespace Base64
 } // namespace phantasma
@@ -31,6 +31,141 @@ class SecureVector;
 template<bool S>
 class TBigInteger;
 
+// Vector of trivially copyable elements that keeps up to N of them inline, and only moves to a heap buffer when it
+// grows past that. The heap pointer shares storage with the inline elements, so the vector is no bigger than them
+// plus a size and a capacity. With Secure set, the heap buffer is pinned and wiped as SecureVector does, and the
+// inline elements are zeroed on destruction.
+template<class T, int N, bool Secure>
+class SmallVector
+{
+  public:
+	typedef size_t size_type;
+
+	SmallVector() {}
+	~SmallVector()
+	{
+		Release();
+		if( Secure )
+			PHANTASMA_WIPEMEM(_inline, sizeof(_inline));
+	}
+	SmallVector(const SmallVector& other)
+	{
+		Assign(other.begin(), other._size);
+	}
+	SmallVector(SmallVector&& other)
+	{
+		*this = std::move(other);
+	}
+	SmallVector& operator=(const SmallVector& other)
+	{
+		if( this != &other )
+			Assign(other.begin(), other._size);
+		return *this;
+	}
+	SmallVector& operator=(SmallVector&& other)
+	{
+		if( this == &other )
+			return *this;
+		if( !other.IsSpilled() )
+		{
+			Assign(other._inline, other._size);
+			return *this;
+		}
+		// Take the other buffer, which goes back to its inline storage
+		Release();
+		_heap = other._heap;
+		_cap = other._cap;
+		_size = other._size;
+		other._cap = N;
+		other._size = 0;
+		return *this;
+	}
+
+	T* begin() { return IsSpilled() ? _heap : _inline; }
+	const T* begin() const { return IsSpilled() ? _heap : _inline; }
+	T* end() { return begin() + _size; }
+	const T* end() const { return begin() + _size; }
+	size_type size() const { return _size; }
+	bool empty() const { return _size == 0; }
+	T& front() { return begin()[0]; }
+	const T& front() const { return begin()[0]; }
+	T& back() { return begin()[_size - 1]; }
+	const T& back() const { return begin()[_size - 1]; }
+	T& operator[](size_type i) { return begin()[i]; }
+	const T& operator[](size_type i) const { return begin()[i]; }
+
+	void reserve(size_type size)
+	{
+		if( size > _cap )
+			Grow(size);
+	}
+	void resize(size_type size)
+	{
+		if( size > _cap )
+			Grow(PHANTASMA_MAX(size, (size_type)_cap * 2));
+		T* p = begin();
+		for( size_type i = _size; i < size; ++i )
+			p[i] = T();
+		_size = (UInt32)size;
+	}
+	void push_back(const T& t)
+	{
+		if( _size == _cap )
+		{
+			T copy = t; // t may live in the buffer that is about to move
+			Grow((size_type)_cap * 2);
+			begin()[_size++] = copy;
+			return;
+		}
+		begin()[_size++] = t;
+	}
+	void pop_back() { --_size; }
+	void clear() { _size = 0; }
+
+  private:
+	UInt32 _size = 0;
+	UInt32 _cap = N;
+	union
+	{
+		T _inline[N];
+		T* _heap;
+	};
+
+	bool IsSpilled() const { return _cap > N; }
+
+	void Assign(const T* src, size_type n)
+	{
+		if( n > _cap )
+			Grow(n);
+		if( n )
+			memcpy(begin(), src, n * sizeof(T));
+		_size = (UInt32)n;
+	}
+	void Grow(size_type cap)
+	{
+		T* heap = new T[cap];
+		if( Secure )
+			PHANTASMA_LOCKMEM(heap, cap * sizeof(T));
+		if( _size )
+			memcpy(heap, begin(), _size * sizeof(T));
+		Release();
+		if( Secure )
+			PHANTASMA_WIPEMEM(_inline, sizeof(_inline));
+		_heap = heap;
+		_cap = (UInt32)cap;
+	}
+	// Frees the heap buffer, if any, and goes back to the inline storage
+	void Release()
+	{
+		if( !IsSpilled() )
+			return;
+		if( Secure )
+			PHANTASMA_UNLOCKMEM(_heap, _cap * sizeof(T));
+		delete[] _heap;
+		_cap = N;
+	}
+};
+
 typedef TBigInteger<false> BigInteger;
 typedef TBigInteger<true> SecureBigInteger;
 
@@ -43,7 +178,11 @@ class TBigInteger
 	typedef SecureVector<UInt32> Data_Secure;
 
 	typedef typename SelectType<UseSecureMemory, Data_Secure, Data_Fast>::Type Data;
-	Data _data;
+	// Magnitude words. Values up to 256 bits are stored inline, so they need no allocation.
+	constexpr static int _InlineWords = 8;
+	typedef SmallVector<UInt32, _InlineWords, UseSecureMemory> Words;
+	typedef typename SelectType<UseSecureMemory, SecureVector<Char>, PHANTASMA_VECTOR<Char>>::Type Chars;
+	Words _data;
 
 	constexpr static int _Base = sizeof(UInt32) * 8; //number of bits required for shift operations
 	constexpr static UInt32 _MaxVal = 0xFFFFFFFFU;
@@ -63,7 +202,7 @@ class TBigInteger
 	TBigInteger() : TBigInteger(0) {}
 
 	TBigInteger(TBigInteger&& other)
-	    : _sign(other._sign), _data(other._data)
+	    : _sign(other._sign), _data(std::move(other._data))
 	{
 	}
 
@@ -79,6 +218,13 @@ class TBigInteger
 		return *this;
 	}
 
+	TBigInteger& operator=(TBigInteger&& other)
+	{
+		_sign = other._sign;
+		_data = std::move(other._data);
+		return *this;
+	}
+
 	TBigInteger(const UInt32* words, int numWords, int sign = 1)
 	{
 		_sign = sign;
@@ -97,6 +243,15 @@ class TBigInteger
 		InitFromArray(buffer.empty() ? 0 : &buffer.front(), (int)buffer.size());
 	}
 
+  private:
+	TBigInteger(const Words& buffer, int sign = 1)
+	{
+		_sign = sign;
+		InitFromArray(buffer.empty() ? 0 : &buffer.front(), (int)buffer.size());
+	}
+
+  public:
+
 	TBigInteger(Int32 val) : TBigInteger((Int64)val)
 	{
 	}
@@ -240,7 +395,7 @@ class TBigInteger
 		}
 		else
 		{
-			Data uintArray;
+			Words uintArray;
 			uintArray.resize((bytes.size() + 3) / 4);
 
 			int bytePosition = 0;
@@ -267,7 +422,7 @@ class TBigInteger
 		}
 		else
 		{
-			Data uintArray;
+			Words uintArray;
 			uintArray.resize((numBytes + 3) / 4);
 
 			int bytePosition = 0;
@@ -343,9 +498,6 @@ class TBigInteger
 	}
 	TBigInteger(const Char* str, int strLength, int radix, bool* out_error = 0)
 	{
-		TBigInteger bigInteger = Zero();
-		TBigInteger bi = One();
-
 		if( str && strLength == 0 )
 		{
 			strLength = (int)PHANTASMA_STRLEN(str);
@@ -384,25 +536,128 @@ class TBigInteger
 
 		for( int i = 0; i < length; i++ )
 		{
-			int val = toupper(last[-i]);
-			val = ((val >= '0' && val <= '9') ? (val - '0') : ((val < 'A' || val > 'Z') ? 9999999 : (val - 'A' + 10)));
-			if( val >= radix )
+			if( DigitValue(first[i]) >= radix )
 			{
 				if( out_error )
 					*out_error = true;
 				PHANTASMA_EXCEPTION("Invalid string in constructor.");
 				return;
 			}
+		}
+
+		if( length <= 0 || radix < 2 )
+		{
+			InitFromArray(0, 0);
+			return;
+		}
+
+		UInt32 chunkPower;
+		const int chunkDigits = RadixChunk(radix, chunkPower);
+		PHANTASMA_VECTOR<TBigInteger> powers;
+		const TBigInteger magnitude = ParseMagnitude(first, length, radix, chunkDigits, chunkPower, powers);
+		InitFromArray(&magnitude._data.front(), (int)magnitude._data.size());
+	}
+
+  private:
+	// Strings longer than this many digits are split in half, so the two halves are joined with one (Karatsuba) multiply
+	constexpr static int _ParseSplitDigits = 1200;
+
+	static int DigitValue(Char c)
+	{
+		int val = toupper(c);
+		return (val >= '0' && val <= '9') ? (val - '0') : ((val < 'A' || val > 'Z') ? 9999999 : (val - 'A' + 10));
+	}
+
+	// Number of radix digits that always fit in a word, and radix raised to that count
+	static int RadixChunk(int radix, UInt32& power)
+	{
+		int digits = 0;
+		power = 1;
+		while( power <= _MaxVal / (UInt32)radix )
+		{
+			power *= radix;
+			digits++;
+		}
+		return digits;
+	}
+
+	// a = a * m + add
+	static void MultiplyAdd(Words& a, UInt32 m, UInt32 add)
+	{
+		UInt64 carry = add;
+		for( int i = 0, end = (int)a.size(); i < end; i++ )
+		{
+			UInt64 tmp = (UInt64)a[i] * m + carry;
+			a[i] = (UInt32)tmp;
+			carry = tmp >> _Base;
+		}
+		if( carry )
+			a.push_back((UInt32)carry);
+	}
 
-			bigInteger += bi * val;
+	// a = a / d, returning the remainder
+	static UInt32 DivideInPlace(UInt32* a, int n, UInt32 d)
+	{
+		UInt64 rem = 0;
+		for( int i = n - 1; i >= 0; i-- )
+		{
+			UInt64 cur = (rem << _Base) | a[i];
+			a[i] = (UInt32)(cur / d);
+			rem = cur % d;
+		}
+		return (UInt32)rem;
+	}
+
+	// As above, with D a template argument so the division compiles to a multiply
+	template<UInt32 D>
+	static UInt32 DivideInPlace(UInt32* a, int n)
+	{
+		const UInt64 d = D;
+		UInt64 rem = 0;
+		for( int i = n - 1; i >= 0; i-- )
+		{
+			UInt64 cur = (rem << _Base) | a[i];
+			a[i] = (UInt32)(cur / d);
+			rem = cur % d;
+		}
+		return (UInt32)rem;
+	}
 
-			if( i + 1 < length )
-				bi *= radix;
+	// Value of already validated digits, most significant first. powers caches radix^(chunkDigits * 2^j).
+	static TBigInteger ParseMagnitude(const Char* digits, int length, int radix, int chunkDigits, UInt32 chunkPower, PHANTASMA_VECTOR<TBigInteger>& powers)
+	{
+		if( length > _ParseSplitDigits )
+		{
+			int j = 0;
+			while( (chunkDigits << (j + 1)) < length )
+				j++;
+			while( (int)powers.size() <= j )
+				powers.push_back(powers.empty() ? TBigInteger((Int64)chunkPower) : powers.back().Squared());
+			const int low = chunkDigits << j;
+			return ParseMagnitude(digits, length - low, radix, chunkDigits, chunkPower, powers) * powers[j] +
+			       ParseMagnitude(digits + length - low, low, radix, chunkDigits, chunkPower, powers);
 		}
 
-		InitFromArray(&bigInteger._data.front(), (int)bigInteger._data.size());
+		Words words;
+		words.reserve(length / chunkDigits + 1);
+		int head = length % chunkDigits;
+		for( int pos = 0; pos < length; )
+		{
+			const int count = pos == 0 && head ? head : chunkDigits;
+			UInt32 chunk = 0;
+			UInt32 scale = 1;
+			for( int k = 0; k < count; k++ )
+			{
+				chunk = chunk * radix + DigitValue(digits[pos + k]);
+				scale *= radix;
+			}
+			MultiplyAdd(words, scale, chunk);
+			pos += count;
+		}
+		return TBigInteger(words);
 	}
 
+  public:
 	static TBigInteger FromHex(const String& p0)
 	{
 		return TBigInteger(p0, 16);
@@ -480,57 +735,87 @@ class TBigInteger
 
 	String ToDecimal() const
 	{
-		int radix = 10;
-		if( radix < 2 || radix > 36 )
-		{
-			PHANTASMA_EXCEPTION("Radix must be >= 2 and <= 36");
-			return String();
-		}
-
-		const Char* digits = PHANTASMA_LITERAL("0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ");
-
-		TBigInteger bi = TBigInteger(radix);
 		if( _data.empty() || (_data.size() == 1 && _data[0] == 0) )
 		{
 			return String(PHANTASMA_LITERAL("0"));
 		}
-		else
+
+		Chars text;
+		text.resize(2 + _data.size() * 10); // a word holds under 10 decimal digits
+		int length = 0;
+		if( _sign < 1 )
+			text[length++] = '-';
+		PHANTASMA_VECTOR<TBigInteger> powers;
+		AppendDecimal(Abs(*this), 0, powers, text, length);
+		return String(&text.front(), length);
+	}
+
+  private:
+	// Values longer than this many words are split by a power of ten and each half is formatted separately
+	constexpr static int _FormatSplitWords = 32;
+
+	// Appends the digits of value >= 0, left-padded with zeros to width. powers caches 10^(9 * 2^j).
+	static void AppendDecimal(const TBigInteger& value, int width, PHANTASMA_VECTOR<TBigInteger>& powers, Chars& text, int& length)
+	{
+		const int words = value._sign == 0 ? 0 : (int)value._data.size();
+		if( words > _FormatSplitWords )
 		{
-			String text2;
-			TBigInteger largeInteger = *this;
-			largeInteger._sign = 1;
-			TBigInteger largeInteger2;
-			TBigInteger largeInteger3;
-			while( largeInteger._data.size() > 1 || (largeInteger._data.size() == 1 && largeInteger._data[0] != 0) )
+			// Largest power whose square is still no longer than the value, so the halves come out balanced
+			size_t j = 0;
+			for( ;; j++ )
 			{
-				DivideAndModulus(largeInteger, bi, largeInteger2, largeInteger3);
-				if( largeInteger3._data.size() == 0 )
-				{
-					String temp(PHANTASMA_LITERAL("0"));
-					temp.append(text2);
-					text2 = temp;
-				}
-				else
-				{
-					int idx = largeInteger3._data[0];
-					String temp;
-					temp.append({ digits[idx] });
-					temp.append(text2);
-					text2 = temp;
-				}
-				largeInteger = largeInteger2;
+				while( powers.size() <= j + 1 )
+					powers.push_back(powers.empty() ? TBigInteger((Int64)1000000000) : powers.back().Squared());
+				if( 2 * powers[j + 1]._data.size() > (size_t)words )
+					break;
 			}
-			if( _sign < 1 && 0 != text2.compare(PHANTASMA_LITERAL("0")) )
+			const int lowDigits = 9 << j;
+			TBigInteger high, low;
+			DivideAndModulus(value, powers[j], high, low);
+			AppendDecimal(high, width > lowDigits ? width - lowDigits : 0, powers, text, length);
+			AppendDecimal(low, lowDigits, powers, text, length);
+			return;
+		}
+
+		// Peel off the largest power of ten that fits in a word, so each pass over the value yields 9 digits
+		constexpr int chunkDigits = 9;
+		Words quotient;
+		Words chunks; // least significant first
+		if( words )
+		{
+			quotient = value._data;
+			chunks.reserve(words * 32 / 29 + 1);
+		}
+		int n = words;
+		while( n > 0 )
+		{
+			chunks.push_back(DivideInPlace<1000000000U>(&quotient.front(), n));
+			n = SignificantWords(&quotient.front(), n);
+		}
+
+		int digits = 0;
+		if( !chunks.empty() )
+		{
+			digits = 1 + chunkDigits * ((int)chunks.size() - 1);
+			for( UInt32 v = chunks.back(); v >= 10; v /= 10 )
+				digits++;
+		}
+		for( int i = digits; i < width; i++ )
+			text[length++] = '0';
+		for( int i = (int)chunks.size() - 1; i >= 0; i-- )
+		{
+			UInt32 chunk = chunks[i];
+			const int count = i == (int)chunks.size() - 1 ? digits - chunkDigits * i : chunkDigits;
+			for( int k = count - 1; k >= 0; k-- )
 			{
-				String temp(PHANTASMA_LITERAL("-"));
-				temp.append(text2);
-				text2 = temp;
+				text[length + k] = (Char)('0' + chunk % 10);
+				chunk /= 10;
 			}
-
-			return text2;
+			length += count;
 		}
 	}
 
+  public:
 	String ToHex() const
 	{
 		StringBuilder builder;
@@ -550,12 +835,12 @@ class TBigInteger
 	}
 
   private:
-	static Data Add(const Data& X, const Data& Y)
+	static Words Add(const Words& X, const Words& Y)
 	{
 		int sizeX = (int)X.size();
 		int sizeY = (int)Y.size();
 		int longest = PHANTASMA_MAX(sizeX, sizeY);
-		Data r;
+		Words r;
 		if( longest == 0 )
 			return r;
 		r.resize(longest + 1);
@@ -575,12 +860,12 @@ class TBigInteger
 		return r;
 	}
 
-	static Data Subtract(const Data& X, const Data& Y)
+	static Words Subtract(const Words& X, const Words& Y)
 	{
 		int sizeX = (int)X.size();
 		int sizeY = (int)Y.size();
 		int longest = PHANTASMA_MAX(sizeX, sizeY);
-		Data r;
+		Words r;
 		if( longest == 0 )
 			return r;
 		r.resize(longest);
@@ -599,38 +884,227 @@ class TBigInteger
 		return r;
 	}
 
-	static Data Multiply(const Data& X, const Data& Y)
+	// Operands at least this many words long are split Karatsuba-style; below it the schoolbook loops win
+	constexpr static int _KaratsubaThreshold = 32;
+	constexpr static int _KaratsubaSquareThreshold = 48;
+
+	static Words Multiply(const Words& X, const Words& Y)
 	{
 		int sizeX = (int)X.size();
 		int sizeY = (int)Y.size();
-		Data output;
+		Words output;
 		if( sizeX == 0 || sizeY == 0 )
 			return output;
 		output.resize(sizeX + sizeY + 1);
+		MulWords(&X.front(), sizeX, &Y.front(), sizeY, &output.front());
+		return output;
+	}
+
+	static Words Square(const Words& X)
+	{
+		int sizeX = (int)X.size();
+		Words output;
+		if( sizeX == 0 )
+			return output;
+		output.resize(2 * sizeX + 1);
+		SqrWords(&X.front(), sizeX, &output.front());
+		return output;
+	}
+
+	// r[0, nr) += a[0, na). The sum must fit in nr words.
+	static void AddInto(UInt32* r, int nr, const UInt32* a, int na)
+	{
+		UInt64 carry = 0;
+		int i = 0;
+		for( ; i < na; i++ )
+		{
+			UInt64 sum = (UInt64)r[i] + a[i] + carry;
+			r[i] = (UInt32)sum;
+			carry = sum >> _Base;
+		}
+		for( ; carry && i < nr; i++ )
+		{
+			UInt64 sum = (UInt64)r[i] + carry;
+			r[i] = (UInt32)sum;
+			carry = sum >> _Base;
+		}
+	}
 
-		for( int i = 0; i < sizeX; i++ )
+	// r[0, nr) -= a[0, na). r must be at least a.
+	static void SubtractInto(UInt32* r, int nr, const UInt32* a, int na)
+	{
+		UInt32 borrow = 0;
+		int i = 0;
+		for( ; i < na; i++ )
 		{
-			if( X[i] == 0 )
+			UInt64 diff = (UInt64)r[i] - a[i] - borrow;
+			r[i] = (UInt32)diff;
+			borrow = (UInt32)(diff >> 63);
+		}
+		for( ; borrow && i < nr; i++ )
+		{
+			borrow = r[i] == 0 ? 1 : 0;
+			r[i]--;
+		}
+	}
+
+	static int SignificantWords(const UInt32* a, int n)
+	{
+		while( n > 0 && a[n - 1] == 0 )
+			n--;
+		return n;
+	}
+
+	// out[0, nx + ny) = x * y. out must not overlap the inputs.
+	static void MulBasecase(const UInt32* x, int nx, const UInt32* y, int ny, UInt32* out)
+	{
+		memset(out, 0, (nx + ny) * sizeof(UInt32));
+		for( int i = 0; i < nx; i++ )
+		{
+			if( x[i] == 0 )
 				continue;
 
-			UInt64 carry = 0uL;
-			Int32 k = i;
+			UInt64 carry = 0;
+			for( int j = 0; j < ny; j++ )
+			{
+				UInt64 tmp = (UInt64)x[i] * y[j] + out[i + j] + carry;
+				out[i + j] = (UInt32)tmp;
+				carry = tmp >> _Base;
+			}
+			out[i + ny] = (UInt32)carry;
+		}
+	}
 
-			for( int j = 0; j < sizeY; j++, k++ )
+	// out[0, 2n) = x * x, computing each cross product once
+	static void SqrBasecase(const UInt32* x, int n, UInt32* out)
+	{
+		memset(out, 0, 2 * n * sizeof(UInt32));
+		for( int i = 0; i < n; i++ )
+		{
+			UInt64 carry = 0;
+			for( int j = i + 1; j < n; j++ )
 			{
-				UInt64 tmp = (UInt64)(X[i] * (Int64)Y[j] + output[k] + (Int64)carry);
-				output[k] = (UInt32)(tmp);
-				carry = tmp >> 32;
+				UInt64 tmp = (UInt64)x[i] * x[j] + out[i + j] + carry;
+				out[i + j] = (UInt32)tmp;
+				carry = tmp >> _Base;
 			}
+			out[i + n] = (UInt32)carry;
+		}
 
-			output[i + sizeY] = (UInt32)carry;
+		UInt32 top = 0;
+		for( int i = 0; i < 2 * n; i++ )
+		{
+			UInt32 w = out[i];
+			out[i] = (w << 1) | top;
+			top = w >> 31;
 		}
 
-		return output;
+		UInt64 carry = 0;
+		for( int i = 0; i < n; i++ )
+		{
+			UInt64 sq = (UInt64)x[i] * x[i];
+			UInt64 lo = (UInt64)out[2 * i] + (UInt32)sq + carry;
+			out[2 * i] = (UInt32)lo;
+			UInt64 hi = (UInt64)out[2 * i + 1] + (sq >> _Base) + (lo >> _Base);
+			out[2 * i + 1] = (UInt32)hi;
+			carry = hi >> _Base;
+		}
+	}
+
+	// out[0, nx + ny) = x * y. out must not overlap the inputs.
+	static void MulWords(const UInt32* x, int nx, const UInt32* y, int ny, UInt32* out)
+	{
+		if( nx < ny )
+		{
+			PHANTASMA_SWAP(x, y);
+			PHANTASMA_SWAP(nx, ny);
+		}
+		if( ny < _KaratsubaThreshold )
+		{
+			MulBasecase(x, nx, y, ny, out);
+			return;
+		}
+
+		if( 2 * ny <= nx )
+		{
+			// Unbalanced: multiply y by ny-word slices of x
+			memset(out, 0, (nx + ny) * sizeof(UInt32));
+			Words slice;
+			slice.resize(2 * ny);
+			for( int offset = 0; offset < nx; offset += ny )
+			{
+				int length = PHANTASMA_MIN(ny, nx - offset);
+				MulWords(x + offset, length, y, ny, &slice.front());
+				AddInto(out + offset, nx + ny - offset, &slice.front(), length + ny);
+			}
+			return;
+		}
+
+		// x = x1*B^h + x0, y = y1*B^h + y0, and x*y = z2*B^2h + ((x0+x1)(y0+y1) - z0 - z2)*B^h + z0
+		const int h = nx / 2;
+		const int nx1 = nx - h;
+		const int ny1 = ny - h;
+		MulWords(x, h, y, h, out);
+		MulWords(x + h, nx1, y + h, ny1, out + 2 * h);
+
+		const int nsx = nx1 + 1;
+		const int nsy = PHANTASMA_MAX(h, ny1) + 1;
+		Words scratch;
+		scratch.resize(nsx + nsy + nsx + nsy);
+		UInt32* sx = &scratch.front();
+		UInt32* sy = sx + nsx;
+		UInt32* z1 = sy + nsy;
+		PHANTASMA_COPY(x + h, x + nx, sx);
+		AddInto(sx, nsx, x, h);
+		if( ny1 >= h )
+		{
+			PHANTASMA_COPY(y + h, y + ny, sy);
+			AddInto(sy, nsy, y, h);
+		}
+		else
+		{
+			PHANTASMA_COPY(y, y + h, sy);
+			AddInto(sy, nsy, y + h, ny1);
+		}
+		MulWords(sx, SignificantWords(sx, nsx), sy, SignificantWords(sy, nsy), z1);
+
+		int nz1 = SignificantWords(sx, nsx) + SignificantWords(sy, nsy);
+		SubtractInto(z1, nz1, out, SignificantWords(out, 2 * h));
+		SubtractInto(z1, nz1, out + 2 * h, SignificantWords(out + 2 * h, nx1 + ny1));
+		AddInto(out + h, nx + ny - h, z1, SignificantWords(z1, nz1));
+	}
+
+	// out[0, 2n) = x * x. out must not overlap the input.
+	static void SqrWords(const UInt32* x, int n, UInt32* out)
+	{
+		if( n < _KaratsubaSquareThreshold )
+		{
+			SqrBasecase(x, n, out);
+			return;
+		}
+
+		const int h = n / 2;
+		const int n1 = n - h;
+		SqrWords(x, h, out);
+		SqrWords(x + h, n1, out + 2 * h);
+
+		const int ns = n1 + 1;
+		Words scratch;
+		scratch.resize(ns + 2 * ns);
+		UInt32* sum = &scratch.front();
+		UInt32* z1 = sum + ns;
+		PHANTASMA_COPY(x + h, x + n, sum);
+		AddInto(sum, ns, x, h);
+		const int nsum = SignificantWords(sum, ns);
+		SqrWords(sum, nsum, z1);
+
+		SubtractInto(z1, 2 * nsum, out, SignificantWords(out, 2 * h));
+		SubtractInto(z1, 2 * nsum, out + 2 * h, SignificantWords(out + 2 * h, 2 * n1));
+		AddInto(out + h, 2 * n - h, z1, SignificantWords(z1, 2 * nsum));
 	}
 
   public:
-	TBigInteger operator+(const TBigInteger& b) const
+	TBigInteger operator+(const TBigInteger& b) const&
 	{
 		const TBigInteger& a = *this;
 		TBigInteger result;
@@ -680,12 +1154,29 @@ class TBigInteger
 
 		return result;
 	}
+	// Rvalue operands lend their storage to the result
+	TBigInteger operator+(const TBigInteger& b) &&
+	{
+		*this += b;
+		return std::move(*this);
+	}
+	TBigInteger operator+(TBigInteger&& b) const&
+	{
+		b += *this;
+		return std::move(b);
+	}
+	TBigInteger operator+(TBigInteger&& b) &&
+	{
+		*this += b;
+		return std::move(*this);
+	}
 	TBigInteger& operator+=(const TBigInteger& b)
 	{
-		return (*this = *this + b);
+		AddSignedInPlace(b, b._sign);
+		return *this;
 	}
 
-	TBigInteger operator-(const TBigInteger& b) const
+	TBigInteger operator-(const TBigInteger& b) const&
 	{
 		const TBigInteger& a = *this;
 		TBigInteger result;
@@ -731,53 +1222,188 @@ class TBigInteger
 
 		return result;
 	}
+	TBigInteger operator-(const TBigInteger& b) &&
+	{
+		*this -= b;
+		return std::move(*this);
+	}
+	TBigInteger operator-(TBigInteger&& b) const&
+	{
+		b._sign = -b._sign;
+		b += *this;
+		return std::move(b);
+	}
+	TBigInteger operator-(TBigInteger&& b) &&
+	{
+		*this -= b;
+		return std::move(*this);
+	}
 	TBigInteger& operator-=(const TBigInteger& b)
 	{
-		return (*this = *this - b);
+		AddSignedInPlace(b, -b._sign);
+		return *this;
+	}
+
+  private:
+	// this += bSign * |b|, working in this value's own storage. b may be this.
+	void AddSignedInPlace(const TBigInteger& b, int bSign)
+	{
+		if( bSign == 0 )
+			return;
+		if( _sign == 0 )
+		{
+			_data = b._data;
+			_sign = bSign;
+			Trim();
+			return;
+		}
+		if( _sign == bSign )
+		{
+			AddMagnitudeInPlace(_data, b._data);
+			return;
+		}
+
+		const int cmp = CompareMagnitudes(_data, b._data);
+		if( cmp == 0 )
+		{
+			_data.resize(1);
+			_data[0] = 0;
+			_sign = 0;
+			return;
+		}
+		if( cmp > 0 )
+		{
+			SubtractInto(&_data.front(), (int)_data.size(), &b._data.front(), SignificantWords(&b._data.front(), (int)b._data.size()));
+		}
+		else
+		{
+			// this = |b| - |this|
+			const int n = (int)b._data.size();
+			_data.resize(n);
+			UInt32 borrow = 0;
+			for( int i = 0; i < n; i++ )
+			{
+				UInt64 diff = (UInt64)b._data[i] - _data[i] - borrow;
+				_data[i] = (UInt32)diff;
+				borrow = (UInt32)(diff >> 63);
+			}
+			_sign = bSign;
+		}
+		Trim();
+	}
+
+	// r += a. a may be r.
+	static void AddMagnitudeInPlace(Words& r, const Words& a)
+	{
+		const int na = (int)a.size();
+		if( (int)r.size() < na )
+			r.resize(na);
+		UInt64 carry = 0;
+		int i = 0;
+		for( ; i < na; i++ )
+		{
+			UInt64 sum = (UInt64)r[i] + a[i] + carry;
+			r[i] = (UInt32)sum;
+			carry = sum >> _Base;
+		}
+		for( int nr = (int)r.size(); carry && i < nr; i++ )
+		{
+			UInt64 sum = (UInt64)r[i] + carry;
+			r[i] = (UInt32)sum;
+			carry = sum >> _Base;
+		}
+		if( carry )
+			r.push_back((UInt32)carry);
+	}
+
+	static int CompareMagnitudes(const Words& a, const Words& b)
+	{
+		const int na = a.empty() ? 0 : SignificantWords(&a.front(), (int)a.size());
+		const int nb = b.empty() ? 0 : SignificantWords(&b.front(), (int)b.size());
+		if( na != nb )
+			return na < nb ? -1 : 1;
+		for( int i = na - 1; i >= 0; i-- )
+		{
+			if( a[i] != b[i] )
+				return a[i] < b[i] ? -1 : 1;
+		}
+		return 0;
 	}
 
+  public:
+
 	TBigInteger operator*(const TBigInteger& b) const
 	{
 		const TBigInteger& a = *this;
 		TBigInteger result;
-		result._data = TBigInteger::Multiply(a._data, b._data);
+		result._data = &a == &b ? TBigInteger::Square(a._data) : TBigInteger::Multiply(a._data, b._data);
 		result._sign = a._sign * b._sign;
 		result.Trim();
 		return result;
 	}
 	TBigInteger& operator*=(const TBigInteger& b)
 	{
-		return (*this = *this * b);
+		if( _sign == 0 || b._sign == 0 )
+		{
+			_data.resize(1);
+			_data[0] = 0;
+			_sign = 0;
+			return *this;
+		}
+		// MulWords must not write over its inputs, so the product goes through a buffer that holds up to 1024 bits
+		// inline, then into this value's own storage
+		const int nx = (int)_data.size();
+		const int ny = (int)b._data.size();
+		ProductBuffer product;
+		product.resize(nx + ny + 1);
+		if( &b == this )
+			SqrWords(&_data.front(), nx, &product.front());
+		else
+			MulWords(&_data.front(), nx, &b._data.front(), ny, &product.front());
+		_data.resize(nx + ny);
+		memcpy(&_data.front(), &product.front(), (nx + ny) * sizeof(UInt32));
+		_sign *= b._sign;
+		Trim();
+		return *this;
 	}
 
 	TBigInteger operator/(const TBigInteger& b) const
 	{
-		const TBigInteger& a = *this;
-		TBigInteger quot, rem;
-		TBigInteger::DivideAndModulus(Abs(a), Abs(b), quot, rem);
-		quot._sign = quot._sign == 0 ? 0 : a._sign * b._sign;
+		TBigInteger quot = *this;
+		quot.DivideBy(b, true);
 		return quot;
 	}
 	TBigInteger& operator/=(const TBigInteger& b)
 	{
-		return (*this = *this / b);
+		DivideBy(b, true);
+		return *this;
 	}
 
 	TBigInteger operator%(const TBigInteger& b) const
 	{
-		const TBigInteger& a = *this;
-		TBigInteger quot, rem;
-		// Match C# BigInteger semantics: remainder keeps dividend sign and division truncates toward zero.
-		TBigInteger::DivideAndModulus(Abs(a), Abs(b), quot, rem);
-		rem._sign = rem.GetBitLength() == 0 ? 0 : a._sign;
+		TBigInteger rem = *this;
+		rem.DivideBy(b, false);
 		return rem;
 	}
 	TBigInteger& operator%=(const TBigInteger& b)
 	{
-		return (*this = *this % b);
+		DivideBy(b, false);
+		return *this;
 	}
 
+	// Reusable working memory for DivideAndModulus. Operands up to 512 by 256 bits need none beyond its inline words;
+	// larger ones grow it once, and later calls with the same scratch reuse that capacity. /= and %= keep one on the
+	// stack, and stay off the heap for dividends up to 600 bits.
+	typedef SmallVector<UInt32, 5 * _InlineWords, UseSecureMemory> DivisionScratch;
+
 	static void DivideAndModulus(const TBigInteger& a, const TBigInteger& b, TBigInteger& quot, TBigInteger& rem)
+	{
+		DivisionScratch scratch;
+		DivideAndModulus(a, b, quot, rem, scratch);
+	}
+
+	// quot and rem keep their storage, so a loop that reuses them and the scratch stays off the heap
+	static void DivideAndModulus(const TBigInteger& a, const TBigInteger& b, TBigInteger& quot, TBigInteger& rem, DivisionScratch& scratch)
 	{
 		if( b._sign == 0 )
 		{
@@ -787,166 +1413,174 @@ class TBigInteger
 			return;
 		}
 
+		if( &quot == &a || &quot == &b || &rem == &a || &rem == &b )
+		{
+			const TBigInteger aCopy = a, bCopy = b;
+			DivideAndModulus(aCopy, bCopy, quot, rem, scratch);
+			return;
+		}
+
 		if( a._data.size() < b._data.size() )
 		{
 			quot = Zero();
-			rem = TBigInteger(a);
+			rem = a;
 			return;
 		}
 
-		if( b._data.size() == 1 )
-			SingleDigitDivMod(a, b, quot, rem);
-		else
-			MultiDigitDivMod(a, b, quot, rem);
+		DivideMagnitudes(a._data, b._data, quot._data, rem._data, scratch);
+		quot._sign = 1;
+		rem._sign = 1;
+		quot.Trim();
+		rem.Trim();
 
 		rem._sign = a._sign;
 		// Remainder sign follows the dividend sign. Do not route this through checked Int32
 		// narrowing: wide values must still format/serialize correctly, and decimal conversion
 		// exercises DivideAndModulus on arbitrarily large operands.
-		rem = a._sign >= 0 ? rem : b + rem;
+		if( a._sign < 0 )
+			rem = b + rem;
 
 		quot._sign = quot.GetBitLength() == 0 ? 0 : a._sign * b._sign;
 		rem._sign = rem.GetBitLength() == 0 ? 0 : rem._sign;
 	}
 
   private:
-	//do not access this function directly under any circumstances, always go through DivideAndModulus
-	static void SingleDigitDivMod(const TBigInteger& numerator, const TBigInteger& denominator, TBigInteger& quotient, TBigInteger& remainder)
-	{
-		Data tmpQuotArray, remArray;
-		tmpQuotArray.resize(numerator._data.size() - denominator._data.size() + 1);
-		remArray.resize(numerator._data.size());
+	typedef SmallVector<UInt32, 4 * _InlineWords, UseSecureMemory> ProductBuffer;
 
-		for( int i = 0, end = (int)numerator._data.size(); i < end; i++ )
+	// this = this / b when quotient is set, else this % b, in this value's own storage. Division truncates toward zero
+	// and the remainder keeps the dividend's sign, as in C# BigInteger. b may be this.
+	void DivideBy(const TBigInteger& b, bool quotient)
+	{
+		if( b._sign == 0 )
 		{
-			remArray[i] = numerator._data[i];
+			PHANTASMA_EXCEPTION_MESSAGE("divide by zero", PHANTASMA_LITERAL("Attempted to divide by zero."));
+			return;
 		}
-
-		int quotIter = 0; //quotient array iterator index
-		UInt64 quickDen = denominator._data[0]; //quick denominator
-		int remIter = (int)remArray.size() - 1; //remainder array iterator index
-		UInt64 tmpRem = remArray[remIter]; //temporary remainder digit
-
-		if( tmpRem >= quickDen )
+		const int sign = quotient ? _sign * b._sign : _sign;
+		const int m = (int)_data.size();
+		const int n = (int)b._data.size();
+		if( m < n )
 		{
-			UInt64 tmpQuot = tmpRem / quickDen;
-			tmpQuotArray[quotIter++] = (UInt32)tmpQuot;
-			remArray[remIter] = (UInt32)(tmpRem % quickDen);
+			if( quotient )
+			{
+				_data.resize(1);
+				_data[0] = 0;
+				_sign = 0;
+			}
+			return;
 		}
-
-		remIter--;
-		while( remIter >= 0 )
+		if( n == 1 )
 		{
-			tmpRem = ((UInt64)remArray[remIter + 1] << 32) + remArray[remIter];
-			UInt64 tmpQuot = tmpRem / quickDen;
-			tmpQuotArray[quotIter++] = (UInt32)tmpQuot;
-			remArray[remIter + 1] = 0u;
-			remArray[remIter--] = (UInt32)(tmpRem % quickDen);
+			const UInt32 r = DivideInPlace(&_data.front(), m, b._data[0]);
+			if( !quotient )
+			{
+				_data.resize(1);
+				_data[0] = r;
+			}
 		}
-
-		Data quotArray;
-		quotArray.resize(quotIter);
-		for( int i = (int)quotArray.size() - 1, j = 0; i >= 0; i--, j++ )
+		else
 		{
-			quotArray[j] = tmpQuotArray[i];
+			// DivModWords reads u and v only to normalize them into un and vn, so the kept result can be written over
+			// them. The discarded remainder goes over un, which it is computed from; the discarded quotient goes after vn.
+			DivisionScratch scratch;
+			scratch.resize(m + 1 + n + (quotient ? 0 : m - n + 1));
+			UInt32* un = &scratch.front();
+			UInt32* vn = un + m + 1;
+			if( quotient )
+			{
+				DivModWords(&_data.front(), m, &b._data.front(), n, &_data.front(), un, un, vn);
+				_data.resize(m - n + 1);
+			}
+			else
+			{
+				DivModWords(&_data.front(), m, &b._data.front(), n, vn + n, &_data.front(), un, vn);
+				_data.resize(n);
+			}
 		}
-
-		quotient._data = quotArray;
-		quotient._sign = 1;
-		remainder._data = remArray;
-		remainder._sign = 1;
-
-		quotient.Trim();
-		remainder.Trim();
+		_sign = sign;
+		Trim();
 	}
 
-	//do not access this function directly under any circumstances, always go through DivideAndModulus
-	static void MultiDigitDivMod(const TBigInteger& numerator, TBigInteger denominator, TBigInteger& quot, TBigInteger& rem)
+  private:
+	// q = u / v and r = u % v on magnitudes, for u at least as long as v. q and r must not be u or v.
+	static void DivideMagnitudes(const Words& u, const Words& v, Words& q, Words& r, DivisionScratch& scratch)
 	{
-		Data quotArray, remArray;
-		quotArray.resize(numerator._data.size() - denominator._data.size() + 1);
-		remArray.resize(numerator._data.size() + 1);
-
-		UInt32 tmp = 0x80000000u;
-		UInt32 tmp2 = denominator._data[denominator._data.size() - 1]; //denominator most significant digit
-		int shiftCount = 0;
-
-		while( tmp != 0 && (tmp2 & tmp) == 0 )
+		const int m = (int)u.size();
+		const int n = (int)v.size();
+		if( n == 1 )
 		{
-			shiftCount++;
-			tmp >>= 1;
-		}
-		for( int i = 0, end = (int)numerator._data.size(); i < end; i++ )
-		{
-			remArray[i] = numerator._data[i];
+			q = u;
+			r.resize(1);
+			r[0] = DivideInPlace(&q.front(), m, v[0]);
+			return;
 		}
-
-		ShiftLeft(remArray, shiftCount);
-		denominator <<= shiftCount;
-
-		int j = (int)numerator._data.size() - (int)denominator._data.size() + 1;
-		int remIter = (int)numerator._data.size(); //yes, numerator, not remArray
-		UInt64 denMsd = denominator._data[(int)denominator._data.size() - 1]; //denominator most significant digit
-		UInt64 denSubMsd = denominator._data[(int)denominator._data.size() - 2]; //denominator second most significant digit
-		int denSize = (int)denominator._data.size() + 1;
-
-		Data tmpRemSubArray;
-		tmpRemSubArray.resize(denSize);
-
-		while( j > 0 )
-		{
-			UInt64 quickDenominator = ((UInt64)remArray[remIter] << 32) + remArray[remIter - 1];
-			UInt64 tmpQuot = quickDenominator / denMsd;
-			UInt64 tmpRem = quickDenominator % denMsd;
-			bool flag = false;
-			while( !flag )
+		q.resize(m - n + 1);
+		r.resize(n);
+		scratch.resize(m + 1 + n);
+		DivModWords(&u.front(), m, &v.front(), n, &q.front(), &r.front(), &scratch.front(), &scratch[m + 1]);
+	}
+
+	// Knuth's algorithm D. q[0, m - n + 1) = u / v and r[0, n) = u % v, for m >= n >= 2 and v[n - 1] != 0.
+	// un is m + 1 words and vn is n words of scratch. q or r may be u or v, since those are only read to fill un and
+	// vn, and r may be un.
+	static void DivModWords(const UInt32* u, int m, const UInt32* v, int n, UInt32* q, UInt32* r, UInt32* un, UInt32* vn)
+	{
+		// Normalize so the divisor's top word has its high bit set
+		int s = 0;
+		while( !(v[n - 1] & (0x80000000u >> s)) )
+			s++;
+		for( int i = n - 1; i > 0; i-- )
+			vn[i] = (v[i] << s) | (s ? v[i - 1] >> (32 - s) : 0);
+		vn[0] = v[0] << s;
+		un[m] = s ? u[m - 1] >> (32 - s) : 0;
+		for( int i = m - 1; i > 0; i-- )
+			un[i] = (u[i] << s) | (s ? u[i - 1] >> (32 - s) : 0);
+		un[0] = u[0] << s;
+
+		for( int j = m - n; j >= 0; j-- )
+		{
+			// Estimate the quotient word from the top two words, then correct it at most twice
+			const UInt64 top = ((UInt64)un[j + n] << _Base) | un[j + n - 1];
+			UInt64 qhat = top / vn[n - 1];
+			UInt64 rhat = top % vn[n - 1];
+			while( (qhat >> _Base) || qhat * vn[n - 2] > ((rhat << _Base) | un[j + n - 2]) )
 			{
-				flag = true;
-				if( tmpQuot == 0x100000000LL || tmpQuot * denSubMsd > (tmpRem << 32) + remArray[remIter - 2] )
-				{
-					tmpQuot--;
-					tmpRem += denMsd;
-					if( tmpRem < 0x100000000LL )
-					{
-						flag = false;
-					}
-				}
+				qhat--;
+				rhat += vn[n - 1];
+				if( rhat >> _Base )
+					break;
 			}
 
-			for( int k = 0; k < denSize; k++ )
+			// un[j, j + n] -= qhat * vn
+			Int64 borrow = 0;
+			for( int i = 0; i < n; i++ )
 			{
-				tmpRemSubArray[(tmpRemSubArray.size() - 1) - k] = remArray[remIter - k];
+				const UInt64 p = qhat * vn[i];
+				const Int64 t = (Int64)un[i + j] - borrow - (Int64)(p & _MaxVal);
+				un[i + j] = (UInt32)t;
+				borrow = (Int64)(p >> _Base) - (t >> _Base);
 			}
+			const Int64 t = (Int64)un[j + n] - borrow;
+			un[j + n] = (UInt32)t;
 
-			TBigInteger tmpRemBigInt(tmpRemSubArray);
-			TBigInteger estimNumBigInt = denominator * (Int64)tmpQuot; //current numerator estimate
-			while( estimNumBigInt > tmpRemBigInt )
+			if( t < 0 )
 			{
-				tmpQuot--;
-				estimNumBigInt -= denominator;
-			}
-			TBigInteger estimRemBigInt = tmpRemBigInt - estimNumBigInt; //current remainder estimate
-			for( int k = 0; k < denSize; k++ )
-			{
-				tmp = denominator._data.size() - k < estimRemBigInt._data.size()
-				          ? estimRemBigInt._data[denominator._data.size() - k]
-				          : 0;
-				remArray[remIter - k] = tmp;
+				// The estimate was one too large: add the divisor back
+				qhat--;
+				UInt64 carry = 0;
+				for( int i = 0; i < n; i++ )
+				{
+					const UInt64 sum = (UInt64)un[i + j] + vn[i] + carry;
+					un[i + j] = (UInt32)sum;
+					carry = sum >> _Base;
+				}
+				un[j + n] += (UInt32)carry;
 			}
-
-			remIter--;
-			j--;
-			quotArray[j] = (UInt32)tmpQuot;
+			q[j] = (UInt32)qhat;
 		}
 
-		quot = TBigInteger(quotArray);
-
-		ShiftRight(remArray, shiftCount);
-
-		rem = TBigInteger(remArray);
-
-		quot.Trim();
-		rem.Trim();
+		for( int i = 0; i < n; i++ )
+			r[i] = (un[i] >> s) | (s ? un[i + 1] << (32 - s) : 0);
 	}
 
   public:
@@ -1032,7 +1666,7 @@ class TBigInteger
 	}
 
   private:
-	static void ShiftRight(Data& buffer, int shiftBitCount)
+	static void ShiftRight(Words& buffer, int shiftBitCount)
 	{
 		int length = (int)buffer.size();
 		if( length == 0 )
@@ -1054,7 +1688,7 @@ class TBigInteger
 			return;
 		}
 
-		Data newBuffer;
+		Words newBuffer;
 		newBuffer.resize(newLength);
 
 		quickShiftAmount = 32 - quickShiftAmount; //we'll use this new shift amount to pre-left shift the applicable digits
@@ -1101,7 +1735,7 @@ class TBigInteger
 	}
 
   private:
-	static void ShiftLeft(Data& buffer, int shiftBitCount)
+	static void ShiftLeft(Words& buffer, int shiftBitCount)
 	{
 		auto length = buffer.size();
 		if( length == 0 )
@@ -1115,7 +1749,7 @@ class TBigInteger
 		int extraDigit = (msd != (UInt32)msd) ? 1 : 0; //if it goes above the UInt32 range, we need to add
 		//a new position for the new MSD
 
-		Data newBuffer;
+		Words newBuffer;
 		newBuffer.resize(length + amountOfZeros + extraDigit);
 
 		for( UInt32 i = 0, j = amountOfZeros; i < length; i++, j++ )
@@ -1137,23 +1771,23 @@ class TBigInteger
   public:
 	TBigInteger& operator++()
 	{
-		return (*this = *this + 1);
+		return (*this += One());
 	}
 	TBigInteger operator++(int)
 	{
 		TBigInteger pre = *this;
-		*this = *this + 1;
+		*this += One();
 		return pre;
 	}
 
 	TBigInteger& operator--()
 	{
-		return (*this = *this - 1);
+		return (*this -= One());
 	}
 	TBigInteger operator--(int)
 	{
 		TBigInteger pre = *this;
-		*this = *this - 1;
+		*this -= One();
 		return pre;
 	}
 
@@ -1214,8 +1848,8 @@ class TBigInteger
 			return !op;
 		}
 
-		const Data& A = a._data;
-		const Data& B = b._data;
+		const Words& A = a._data;
+		const Words& B = b._data;
 		for( int i = (int)A.size() - 1; i >= 0; i-- )
 		{
 			UInt32 x = A[i];
@@ -1372,14 +2006,32 @@ class TBigInteger
 			return Zero();
 		}
 
-		TBigInteger val = One();
-		for( int i = 0; i < exponent; ++i )
+		if( exponent == 0 )
+			return One();
+
+		// Square-and-multiply, from the top exponent bit down
+		int bit = 30;
+		while( !((exponent >> bit) & 1) )
+			--bit;
+		TBigInteger val = powBase;
+		while( bit-- > 0 )
 		{
-			val *= powBase;
+			val = val.Squared();
+			if( (exponent >> bit) & 1 )
+				val *= powBase;
 		}
 		return val;
 	}
 
+	TBigInteger Squared() const
+	{
+		TBigInteger result;
+		result._data = Square(_data);
+		result._sign = _sign * _sign;
+		result.Trim();
+		return result;
+	}
+
 	static TBigInteger ModPow(TBigInteger b, TBigInteger exp, TBigInteger mod)
 	{
 		return b.ModPow(exp, mod);
@@ -1406,21 +2058,116 @@ class TBigInteger
 		if( exp == 1 )
 			return *this % mod;
 
+		if( exp._sign == 0 )
+			return One();
+
+		// The result is |this|^exp mod mod, negated when this is negative and exp is odd, as C# BigInteger gives
+		TBigInteger result = (mod._data[0] & 1) ? MontgomeryModPow(Abs(*this) % mod, exp, mod) : PlainModPow(Abs(*this) % mod, exp, mod);
+		if( _sign < 0 && (exp._data[0] & 1) && result._sign != 0 )
+			result._sign = -1;
+		return result;
+	}
+
+  private:
+	// base in [0, mod), exp > 0
+	static TBigInteger PlainModPow(TBigInteger base, const TBigInteger& exp, const TBigInteger& mod)
+	{
 		TBigInteger s = One();
-		TBigInteger t = *this;
+		const int bits = exp.GetBitLength();
+		for( int bit = 0; bit < bits; ++bit )
+		{
+			if( (exp._data[bit / 32] >> (bit % 32)) & 1 )
+				s = (s * base) % mod;
+			if( bit + 1 < bits )
+				base = base.Squared() % mod;
+		}
+		return s;
+	}
+
+	// base in [0, mod), exp > 0, mod odd. Works on residues scaled by R = 2^(32n), so each step reduces with
+	// word multiplies and shifts instead of a division.
+	static TBigInteger MontgomeryModPow(const TBigInteger& base, const TBigInteger& exp, const TBigInteger& mod)
+	{
+		const int n = (int)mod._data.size();
+		const UInt32* m = &mod._data.front();
+
+		// -m^-1 mod 2^32 by Newton iteration; m*m == 1 mod 8 seeds 3 correct bits, each step doubles them
+		UInt32 inverse = m[0];
+		for( int i = 0; i < 4; ++i )
+			inverse *= 2 - m[0] * inverse;
+		const UInt32 mPrime = (UInt32)0 - inverse;
+
+		Words scratch;
+		scratch.resize(4 * n + 2);
+		UInt32* x = &scratch.front(); // base * R mod m
+		UInt32* acc = x + n;
+		UInt32* t = acc + n; // n + 2 words
+
+		const TBigInteger xR = (base << (32 * n)) % mod;
+		const TBigInteger oneR = (One() << (32 * n)) % mod;
+		if( xR._sign != 0 )
+			PHANTASMA_COPY(xR._data.begin(), xR._data.end(), x);
+		if( oneR._sign != 0 )
+			PHANTASMA_COPY(oneR._data.begin(), oneR._data.end(), acc);
+
+		for( int bit = exp.GetBitLength() - 1; bit >= 0; --bit )
+		{
+			MontgomeryMultiply(acc, acc, m, n, mPrime, t);
+			if( (exp._data[bit / 32] >> (bit % 32)) & 1 )
+				MontgomeryMultiply(acc, x, m, n, mPrime, t);
+		}
 
-		while( exp != Zero() )
+		// Leave Montgomery form by multiplying with plain 1
+		memset(x, 0, n * sizeof(UInt32));
+		x[0] = 1;
+		MontgomeryMultiply(acc, x, m, n, mPrime, t);
+		return TBigInteger(acc, n, 1);
+	}
+
+	// a = a * b / R mod m, with a, b < m. t is n + 2 words of scratch.
+	static void MontgomeryMultiply(UInt32* a, const UInt32* b, const UInt32* m, int n, UInt32 mPrime, UInt32* t)
+	{
+		memset(t, 0, (n + 2) * sizeof(UInt32));
+		for( int i = 0; i < n; i++ )
 		{
-			if( (exp & One()) == One() )
-				s = (s * t) % mod;
+			UInt64 carry = 0;
+			for( int j = 0; j < n; j++ )
+			{
+				UInt64 tmp = (UInt64)a[j] * b[i] + t[j] + carry;
+				t[j] = (UInt32)tmp;
+				carry = tmp >> _Base;
+			}
+			UInt64 tmp = (UInt64)t[n] + carry;
+			t[n] = (UInt32)tmp;
+			t[n + 1] = (UInt32)(tmp >> _Base);
 
-			exp = exp >> 1;
-			t = (t * t) % mod;
+			const UInt32 q = t[0] * mPrime;
+			carry = ((UInt64)q * m[0] + t[0]) >> _Base;
+			for( int j = 1; j < n; j++ )
+			{
+				tmp = (UInt64)q * m[j] + t[j] + carry;
+				t[j - 1] = (UInt32)tmp;
+				carry = tmp >> _Base;
+			}
+			tmp = (UInt64)t[n] + carry;
+			t[n - 1] = (UInt32)tmp;
+			t[n] = t[n + 1] + (UInt32)(tmp >> _Base);
 		}
 
-		return s;
+		bool reduce = t[n] != 0;
+		if( !reduce )
+		{
+			int i = n - 1;
+			while( i > 0 && t[i] == m[i] )
+				i--;
+			reduce = t[i] >= m[i];
+		}
+		if( reduce )
+			SubtractInto(t, n + 1, m, n);
+		PHANTASMA_COPY(t, t + n, a);
 	}
 
+  public:
 	TBigInteger ModInverse(TBigInteger modulus) const
 	{
 		TBigInteger array[2] = {
@@ -1534,7 +2281,11 @@ class TBigInteger
 
 	Data ToUintArray() const
 	{
-		return _data;
+		Data words;
+		words.resize(_data.size());
+		if( !_data.empty() )
+			PHANTASMA_COPY(_data.begin(), _data.end(), &words.front());
+		return words;
 	}
 
 	bool CalcIsEven() const
@@ -1574,7 +2325,7 @@ class TBigInteger
 			num2++;
 		}
 
-		Data sqrtArray;
+		Words sqrtArray;
 		sqrtArray.resize(num2);
 		for( int num4 = (int)(num2 - 1); num4 >= 0; num4-- )
 		{
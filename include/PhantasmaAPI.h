@@ -390,6 +390,21 @@
 //  |`PHANTASMA_Ed25519_SignDetached`       | Generate a 64 byte signature from a message and a private key.|
 //  |`PHANTASMA_Ed25519_ValidateDetached`   | Validate a 64 byte signature using a public key.              |
 //
+//  Optionally, `PHANTASMA_Ed25519_ValidateDetachedBatch` validates many signatures in one call (see
+//  `Ed25519::VerifyBatch`); without it each signature goes through `PHANTASMA_Ed25519_ValidateDetached`.
+//  Either way every signature in a batch is still verified on its own; there is no randomized batch equation. The
+//  OpenSSL adaptor implements the hook to reuse one digest context and the decoded keys across the batch.
+//
+//  Optionally, `PHANTASMA_Ed25519_SignerCreate`, `_SignerSign` and `_SignerFree` manage an opaque signing context
+//  made from a seed, which `PhantasmaKeys` creates on its first signature and reuses until the key is destroyed
+//  (see `Ed25519::Signer`). The OpenSSL adaptor implements them.
+//
+//  `PHANTASMA_SHA256` hashes a whole message. Adaptors may also supply an incremental hash (see `SHA256Hasher`)
+//  through `PHANTASMA_SHA256_STATE`, `_INIT`, `_UPDATE`, `_FINAL`, `_EXPORT` and `_IMPORT`; without them a built-in
+//  implementation is used. The OpenSSL and Sodium adaptors implement them. An adaptor that defines
+//  `PHANTASMA_SHA256_BUILTIN` lets `SHA256` use the built-in hash instead on x86-64 CPUs with the SHA extensions
+//  (unless `PHANTASMA_NO_SIMD` is defined); the OpenSSL and Sodium adaptors do, and `#undef PHANTASMA_SHA256_BUILTIN`
+//  after including them keeps every `SHA256` call on the library. `SHA256Many` always hashes with the built-in code.
 //
 
 //------------------------------------------------------------------------------
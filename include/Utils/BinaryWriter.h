@@ -12,6 +12,28 @@ class Signature;
 class BinaryWriter
 {
 	ByteArray stream;
+	// When set, the output goes to this callback instead of the stream
+	void (*sink)(void* context, const Byte* bytes, size_t length) = 0;
+	void* sinkContext = 0;
+	UInt32 sinkPosition = 0;
+
+	void Put(Byte b)
+	{
+		if( sink )
+			Put(&b, 1);
+		else
+			stream.push_back(b);
+	}
+	void Put(const Byte* b, int size)
+	{
+		if( sink )
+		{
+			sink(sinkContext, b, (size_t)size);
+			sinkPosition += (UInt32)size;
+		}
+		else
+			stream.insert(stream.end(), b, b + size);
+	}
 
   public:
 	BinaryWriter(UInt32 sizeHint = 4096)
@@ -19,24 +41,39 @@ class BinaryWriter
 		stream.reserve(sizeHint);
 	}
 
-	void Clear() { stream.clear(); }
-	UInt32 Position() const { return (UInt32)stream.size(); }
+	// A writer that hands everything written to Output::Sink instead of keeping it, e.g. to hash a serialization with
+	// a SHA256Hasher without building it in memory first. ToArray stays empty.
+	template<class Output>
+	static BinaryWriter ToSink(Output& output)
+	{
+		BinaryWriter writer(0);
+		writer.sink = &Output::Sink;
+		writer.sinkContext = &output;
+		return writer;
+	}
+
+	void Clear()
+	{
+		stream.clear();
+		sinkPosition = 0;
+	}
+	UInt32 Position() const { return sink ? sinkPosition : (UInt32)stream.size(); }
 
 	const ByteArray& ToArray() const { return stream; }
 	ByteArray& ToArray() { return stream; }
 
 	void Write(uint8_t b)
 	{
-		stream.push_back((Byte)b);
+		Put((Byte)b);
 	}
 	void Write(int8_t b)
 	{
-		stream.push_back((Byte)b);
+		Put((Byte)b);
 	}
 	void Write(uint16_t b)
 	{
-		stream.push_back((Byte)(b & 0xFF));
-		stream.push_back((Byte)((b >> 8) & 0xFF));
+		const Byte bytes[2] = { (Byte)(b & 0xFF), (Byte)((b >> 8) & 0xFF) };
+		Put(bytes, 2);
 	}
 	void Write(int16_t b)
 	{
@@ -44,10 +81,8 @@ class BinaryWriter
 	}
 	void Write(uint32_t b)
 	{
-		stream.push_back((Byte)(b & 0xFF));
-		stream.push_back((Byte)((b >> 8) & 0xFF));
-		stream.push_back((Byte)((b >> 16) & 0xFF));
-		stream.push_back((Byte)((b >> 24) & 0xFF));
+		const Byte bytes[4] = { (Byte)(b & 0xFF), (Byte)((b >> 8) & 0xFF), (Byte)((b >> 16) & 0xFF), (Byte)((b >> 24) & 0xFF) };
+		Put(bytes, 4);
 	}
 	void Write(int32_t b)
 	{
@@ -65,8 +100,8 @@ class BinaryWriter
 
 	void Write(const Byte* b, int size)
 	{
-		for( int i = 0; i < size; ++i )
-			stream.push_back(b[i]);
+		if( size > 0 )
+			Put(b, size);
 	}
 	void Write(const ByteArray& bytes)
 	{
@@ -0,0 +1,102 @@
+#pragma once
+#ifndef PHANTASMA_API_INCLUDED
+#error "Configure and include PhantasmaAPI.h first"
+#endif
+
+// Vector kernels are built for x86-64 (SSE2 always, AVX2 when the CPU reports it at run time) and AArch64 (NEON).
+// Define PHANTASMA_NO_SIMD before including PhantasmaAPI.h to build only the scalar code.
+#if !defined(PHANTASMA_NO_SIMD)
+#if defined(__x86_64__) || defined(_M_X64)
+#define PHANTASMA_SIMD_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define PHANTASMA_SIMD_NEON 1
+#include <arm_neon.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 instructions in functions that ask for them; MSVC emits them anywhere
+#if defined(PHANTASMA_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+#define PHANTASMA_TARGET_AVX2 __attribute__((target("avx2")))
+#define PHANTASMA_TARGET_SHA __attribute__((target("sha,sse4.1,ssse3")))
+#else
+#define PHANTASMA_TARGET_AVX2
+#define PHANTASMA_TARGET_SHA
+#endif
+
+namespace phantasma {
+namespace Cpu {
+
+enum class Isa
+{
+	Scalar,
+	SSE2,
+	AVX2,
+	NEON,
+};
+
+inline Isa DetectIsa()
+{
+#if defined(PHANTASMA_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+	// Also checks that the OS saves the YMM registers
+	return __builtin_cpu_supports("avx2") ? Isa::AVX2 : Isa::SSE2;
+#elif defined(PHANTASMA_SIMD_X86) && defined(_MSC_VER)
+	int regs[4];
+	__cpuid(regs, 1);
+	const bool osxsave = (regs[2] & (1 << 27)) != 0;
+	const bool avx = (regs[2] & (1 << 28)) != 0;
+	if( !osxsave || !avx || (_xgetbv(0) & 6) != 6 )
+		return Isa::SSE2;
+	__cpuidex(regs, 7, 0);
+	return (regs[1] & (1 << 5)) ? Isa::AVX2 : Isa::SSE2;
+#elif defined(PHANTASMA_SIMD_NEON)
+	return Isa::NEON;
+#else
+	return Isa::Scalar;
+#endif
+}
+
+// The widest instruction set available, detected once per process
+inline Isa ActiveIsa()
+{
+	static const Isa isa = DetectIsa();
+	return isa;
+}
+
+// The x86 SHA extensions (SHA-NI), along with the SSSE3/SSE4.1 shuffles and blends that go with them
+inline bool DetectSha()
+{
+#if defined(PHANTASMA_SIMD_X86)
+	unsigned int regs[4] = {};
+#if defined(_MSC_VER)
+	__cpuid((int*)regs, 1);
+#else
+	__get_cpuid(1, &regs[0], &regs[1], &regs[2], &regs[3]);
+#endif
+	const bool ssse3 = (regs[2] & (1 << 9)) != 0;
+	const bool sse41 = (regs[2] & (1 << 19)) != 0;
+#if defined(_MSC_VER)
+	__cpuidex((int*)regs, 7, 0);
+#else
+	if( !__get_cpuid_count(7, 0, &regs[0], &regs[1], &regs[2], &regs[3]) )
+		return false;
+#endif
+	return ssse3 && sse41 && (regs[1] & (1 << 29)) != 0;
+#else
+	return false;
+#endif
+}
+
+inline bool HasSha()
+{
+	static const bool sha = DetectSha();
+	return sha;
+}
+
+} // namespace Cpu
+} // namespace phantasma
@@ -9,4 +9,14 @@ inline BigInteger NftIdFromNftRom(const ByteArray& rom)
 	return BigInteger(Hash::FromBytes(rom).ToByteArray(), Hash::Length);
 }
 
+inline void NftIdsFromNftRoms(const ByteArray* roms, BigInteger* ids, int count)
+{
+	if( count <= 0 )
+		return;
+	PHANTASMA_VECTOR<Hash> hashes(count);
+	Hash::FromBytesMany(roms, &hashes.front(), count);
+	for( int i = 0; i < count; ++i )
+		ids[i] = BigInteger(hashes[i].ToByteArray(), Hash::Length);
+}
+
 } // namespace phantasma
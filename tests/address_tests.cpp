@@ -1,5 +1,7 @@
 #include "test_cases.h"
 
+#include "../include/Cryptography/AddressBatch.h"
+
 namespace testcases {
 using namespace testutil;
 
@@ -20,6 +22,97 @@ void RunAddressTests(TestContext& ctx)
 	Report(ctx, nullAddr.IsNull(), "Address null");
 	const bool nullLabelOk = nullAddr.ToString() == PHANTASMA_LITERAL("[Null address]");
 	Report(ctx, nullLabelOk, "Address null label");
+
+	bool error = false;
+	Address::FromText("P2KFEyFevpQfSaW8G4VjSmhWUZXR4QrG9YQR1HbMpTUCp", 0, &error);
+	Report(ctx, error, "Address from short text fails");
+	error = false;
+	Address::FromText((expected + "1").c_str(), 0, &error);
+	Report(ctx, error, "Address from long text fails");
+
+	{
+		AddressTable& table = AddressTable::Global();
+		table.SetCapacity(100);
+		table.ResetStats();
+		const Address first = Address::FromText(expected.c_str(), (int)expected.size());
+		const Address second = Address::FromText(expected.c_str(), (int)expected.size());
+		const bool textOk = std::string(Address(first.ToByteArray(), Address::LengthInBytes).Text().c_str()) == expected &&
+		                    std::string(Address(second.ToByteArray(), Address::LengthInBytes).Text().c_str()) == expected;
+		AddressTable::Stats stats = table.GetStats();
+		Report(ctx, first == addr && second == addr && textOk, "Address table roundtrip");
+		Report(ctx, stats.parseMisses == 1 && stats.parseHits == 1 && stats.textMisses == 1 && stats.textHits == 1,
+		    "Address table hit and miss counters");
+
+		error = false;
+		Address::FromText(("S" + expected.substr(1)).c_str(), 0, &error);
+		Report(ctx, error, "Address table does not record rejected text");
+
+		// Far more addresses than the table holds; the oldest are evicted and every lookup stays correct
+		bool evictOk = table.Capacity() == 128;
+		for( int i = 0; i < 2000; ++i )
+		{
+			Byte bytes[Address::LengthInBytes] = {};
+			bytes[0] = (Byte)AddressKind::User;
+			bytes[2] = (Byte)i;
+			bytes[3] = (Byte)(i >> 8);
+			const String text = Address(bytes, Address::LengthInBytes).Text();
+			evictOk &= Address::FromText(text) == Address(bytes, Address::LengthInBytes);
+		}
+		stats = table.GetStats();
+		evictOk &= stats.textMisses == 1 + 2000 && stats.parseMisses == 1 + 2000 + 1;
+		Report(ctx, evictOk, "Address table stays bounded");
+		table.SetCapacity(0);
+	}
+	{
+		// Enough entries for several ranges per thread, with two of every three texts broken in different ways
+		const int count = 1500;
+		std::vector<Address> addresses(count);
+		std::vector<String> texts(count);
+		for( int i = 0; i < count; ++i )
+		{
+			Byte bytes[Address::LengthInBytes] = {};
+			bytes[0] = (Byte)(i % 2 ? AddressKind::User : AddressKind::System);
+			for( int j = 2; j < Address::LengthInBytes; ++j )
+				bytes[j] = (Byte)(i * 31 + j * 7);
+			addresses[i] = Address(bytes, Address::LengthInBytes);
+		}
+		std::vector<String> formatted(count);
+		AddressBatch::ToText(addresses.data(), count, formatted.data(), 4);
+		bool formatOk = true;
+		for( int i = 0; i < count; ++i )
+		{
+			formatOk &= formatted[i] == addresses[i].Text();
+			texts[i] = formatted[i];
+			if( i % 3 == 1 )
+				texts[i][0] = texts[i][0] == 'P' ? 'S' : 'P';
+			else if( i % 6 == 2 )
+				texts[i].pop_back();
+			else if( i % 6 == 5 )
+				texts[i][10] = '0'; // not in the Base58 alphabet
+		}
+		Report(ctx, formatOk, "Address batch format");
+
+		error = false;
+		Address::FromText(texts[5], &error);
+		Report(ctx, error, "Address with a character outside Base58 reports through out_error");
+
+		std::vector<Address> parsed(count);
+		std::vector<Byte> status(AddressBatch::StatusBytes(count));
+		const int valid = AddressBatch::FromText(texts.data(), count, parsed.data(), status.data(), 4);
+		bool parseOk = valid == (count + 2) / 3;
+		for( int i = 0; i < count; ++i )
+		{
+			const bool expectValid = i % 3 == 0;
+			parseOk &= AddressBatch::IsValid(status.data(), i) == expectValid;
+			parseOk &= expectValid ? parsed[i] == addresses[i] : parsed[i].IsNull();
+		}
+		Report(ctx, parseOk, "Address batch parse with status bitmap");
+
+		const Char* raw[] = { formatted[0].c_str(), PHANTASMA_LITERAL(""), 0, formatted[3].c_str() };
+		Byte rawStatus[1] = {};
+		const bool rawOk = AddressBatch::FromText(raw, 0, 4, 0, rawStatus) == 2 && rawStatus[0] == 0x9;
+		Report(ctx, rawOk, "Address batch validation of raw texts");
+	}
 }
 
 } // namespace testcases
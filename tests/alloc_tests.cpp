@@ -0,0 +1,181 @@
+#include "test_cases.h"
+
+namespace testcases {
+using namespace testutil;
+
+void RunAllocatorTests(TestContext& ctx)
+{
+	{
+		Report(ctx, ChunkPool::RoundUp(1) == ChunkPool::MinChunkSize, "ChunkPool rounds small requests to 64k");
+		Report(ctx, ChunkPool::RoundUp(ChunkPool::MinChunkSize + 1) == ChunkPool::MinChunkSize * 2, "ChunkPool rounds to next size class");
+		Report(ctx, ChunkPool::RoundUp(ChunkPool::MaxChunkSize + 1) == ChunkPool::MaxChunkSize + ChunkPool::MinChunkSize, "ChunkPool rounds oversized requests to 64k multiples");
+	}
+	{
+		ChunkPool* pool = ChunkPool::Local();
+		pool->Trim();
+		uint8_t* a = ChunkPool::Acquire(ChunkPool::MinChunkSize);
+		ChunkPool::Release(a, ChunkPool::MinChunkSize);
+		const bool retained = pool->RetainedChunks() == 1 && pool->RetainedBytes() == ChunkPool::MinChunkSize;
+		uint8_t* b = ChunkPool::Acquire(ChunkPool::MinChunkSize);
+		Report(ctx, retained && a == b && pool->RetainedChunks() == 0, "ChunkPool recycles released chunks");
+		ChunkPool::Release(b, ChunkPool::MinChunkSize);
+
+		const size_t oversized = ChunkPool::RoundUp(ChunkPool::MaxChunkSize + 1);
+		ChunkPool::Release(ChunkPool::Acquire(oversized), oversized);
+		Report(ctx, pool->RetainedChunks() == 1, "ChunkPool does not retain oversized chunks");
+		pool->Trim();
+	}
+	{
+		ChunkPool* pool = ChunkPool::Local();
+		pool->Trim();
+		pool->SetLimit(2);
+		std::vector<uint8_t*> chunks;
+		for( int i = 0; i != 4; ++i )
+			chunks.push_back(ChunkPool::Acquire(ChunkPool::MinChunkSize));
+		for( uint8_t* c : chunks )
+			ChunkPool::Release(c, ChunkPool::MinChunkSize);
+		Report(ctx, pool->RetainedChunks() == 2, "ChunkPool respects retention limit");
+		pool->SetLimit(0);
+		Report(ctx, pool->RetainedChunks() == 0, "ChunkPool limit of zero releases everything");
+		pool->SetLimit(ChunkPool::MaxRetained);
+	}
+	{
+		ChunkPool* pool = ChunkPool::Local();
+		pool->Trim();
+		bool ok = true;
+		for( int i = 0; i != 100 && ok; ++i )
+		{
+			Allocator alloc;
+			uint64_t* small = alloc.Alloc<uint64_t>(16);
+			uint8_t* large = alloc.Alloc<uint8_t>(ChunkPool::MinChunkSize * 3);
+			small[15] = (uint64_t)i;
+			large[ChunkPool::MinChunkSize * 3 - 1] = (uint8_t)i;
+			ok = small[15] == (uint64_t)i && alloc.Dbg_IsOwner(large);
+		}
+		Report(ctx, ok && pool->RetainedChunks() == 2 && pool->RetainedBytes() == ChunkPool::MinChunkSize * 5, "Allocator reuses pooled chunks across instances");
+		pool->Trim();
+	}
+	{
+		Allocator alloc;
+		uint32_t* keep = alloc.Alloc<uint32_t>(4);
+		keep[0] = 0x12345678;
+		const AllocatorCheckpoint checkpoint = alloc.Checkpoint();
+		uint8_t* speculative = alloc.Alloc<uint8_t>(100);
+		alloc.Alloc<uint8_t>(ChunkPool::MinChunkSize * 2);
+		alloc.RewindTo(checkpoint);
+		uint8_t* again = alloc.Alloc<uint8_t>(100);
+		Report(ctx, again == speculative && keep[0] == 0x12345678 && alloc.Dbg_IsOwner(keep) && !alloc.Dbg_IsOwner(again + 100), "Allocator RewindTo releases later allocations");
+
+		const AllocatorCheckpoint stale = alloc.Checkpoint();
+		alloc.Clear();
+		ExpectThrowContains(ctx, "Allocator RewindTo rejects stale checkpoint", "before the last Clear", [&]()
+		    { alloc.RewindTo(stale); });
+	}
+	{
+		Allocator alloc;
+		const ByteArray truncated = HexToBytes("FEFFFFFF020000004100000000");
+		ReadView r(truncated, alloc, ReadView::InPlace);
+		const AllocatorCheckpoint before = alloc.Checkpoint();
+		uint8_t* expected = alloc.Alloc<uint8_t>(1);
+		alloc.RewindTo(before);
+		Blockchain::MsgCallArgSections sections{};
+		bool failed = true;
+		PHANTASMA_TRY
+		{
+			failed = !Read(sections, r, alloc);
+		}
+		PHANTASMA_CATCH_ALL()
+		{
+		}
+		// Whether the truncated section failed by return value or by exception, the arena is back where it was
+		Report(ctx, failed && !sections.argSections && expected == alloc.Alloc<uint8_t>(1), "MsgCallArgSections failure does not leak arena space");
+	}
+	{
+		WriteView counter;
+		Write4((uint32_t)7, counter);
+		counter.WriteByte(1);
+		WriteArray(HexToBytes("0A0B0C"), counter);
+		Report(ctx, counter.Counting() && counter.Size() == 12 && counter.View().length == 0, "WriteView counting mode");
+
+		uint8_t fixed[8] = {};
+		WriteView w(fixed, sizeof(fixed));
+		Write4((uint32_t)0x04030201, w);
+		w.WriteByte(5);
+		const bool fits = !w.Overflow() && w.Size() == 5 && BytesToHex(BytesFromView(w.View())) == "0102030405";
+		Report(ctx, fits, "WriteView fixed-buffer mode");
+		PHANTASMA_TRY
+		{
+			Write4((uint32_t)0, w);
+		}
+		PHANTASMA_CATCH_ALL()
+		{
+		}
+		Report(ctx, w.Overflow() && w.Size() == 5, "WriteView fixed-buffer overflow is not written");
+
+		WriteView null(nullptr, 16);
+		PHANTASMA_TRY
+		{
+			null.WriteByte(1);
+		}
+		PHANTASMA_CATCH_ALL()
+		{
+		}
+		Report(ctx, !null.Counting() && null.Overflow() && null.Size() == 0, "WriteView null buffer overflows");
+	}
+	{
+		const AllocStatsSnapshot* found = nullptr;
+		std::vector<AllocStatsSnapshot> snapshot;
+		{
+			Allocator alloc("alloc-tests");
+			alloc.Alloc<uint8_t>(3);
+			alloc.Alloc<uint64_t>(2);
+			alloc.Clone(ByteView{ (const uint8_t*)"abcd", 4 });
+			alloc.Clear();
+			alloc.Alloc<uint8_t>(ChunkPool::MinChunkSize + 1);
+			snapshot = GetAllocTelemetry().Snapshot();
+			for( const auto& s : snapshot )
+				found = s.tag == "alloc-tests" ? &s : found;
+			Report(ctx, found && found->chunksLive == 2 && found->chunkBytesLive == ChunkPool::MinChunkSize * 3 && found->chunkBytesPeak >= found->chunkBytesLive, "AllocTelemetry tracks live chunks");
+		}
+		snapshot = GetAllocTelemetry().Snapshot();
+		found = nullptr;
+		for( const auto& s : snapshot )
+			found = s.tag == "alloc-tests" ? &s : found;
+		const bool ok = found &&
+		                found->allocators == 1 &&
+		                found->clears == 1 &&
+		                found->bytesRequested == 3 + 16 + 4 + ChunkPool::MinChunkSize + 1 &&
+		                found->bytesPadding == 5 &&
+		                found->chunksAllocated == 2 &&
+		                found->chunksLive == 0 &&
+		                found->chunkBytesLive == 0 &&
+		                found->arenaBytesPeak == ChunkPool::MinChunkSize + 1 &&
+		                found->bytesSlack == (ChunkPool::MinChunkSize - 28) + (ChunkPool::MinChunkSize * 3 - (ChunkPool::MinChunkSize + 1));
+		Report(ctx, ok, "AllocTelemetry accumulates per-tag counters");
+		const std::string json = GetAllocTelemetry().ToJson();
+		Report(ctx, json.front() == '[' && json.back() == ']' && json.find("{\"tag\":\"alloc-tests\",\"allocators\":1,") != std::string::npos, "AllocTelemetry JSON", json);
+	}
+	{
+		// A tag buffer reused with new text at the same address is counted under the new text
+		char tag[32];
+		std::strcpy(tag, "alloc-tests-reused-a");
+		{
+			Allocator first(tag);
+		}
+		std::strcpy(tag, "alloc-tests-reused-b");
+		{
+			Allocator second(tag);
+		}
+		uint64_t a = 0, b = 0;
+		for( const auto& s : GetAllocTelemetry().Snapshot() )
+		{
+			if( s.tag == "alloc-tests-reused-a" )
+				a = s.allocators;
+			if( s.tag == "alloc-tests-reused-b" )
+				b = s.allocators;
+		}
+		Report(ctx, a == 1 && b == 1, "AllocTelemetry tag buffer reused with new text");
+	}
+}
+
+} // namespace testcases
@@ -1,5 +1,29 @@
 #include "test_cases.h"
 
+#include <cstdlib>
+#include <new>
+
+// Counts heap allocations made by this thread while counting is on, to check that in-place arithmetic reuses storage
+static thread_local bool g_countAllocations = false;
+static thread_local int g_allocations = 0;
+
+void* operator new(size_t size)
+{
+	if( g_countAllocations )
+		++g_allocations;
+	if( void* p = std::malloc(size ? size : 1) )
+		return p;
+	throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+void operator delete(void* p, size_t) noexcept
+{
+	std::free(p);
+}
+
 namespace testcases {
 using namespace testutil;
 
@@ -1094,4 +1118,262 @@ void RunBigIntMultiWordTests(TestContext& ctx)
 	Report(ctx, (A << 19).ToString() == String(PHANTASMA_LITERAL("178405961588244985141957152738103925446017024")), "BigInt multi A<<19");
 }
 
+void RunBigIntInlineStorageTests(TestContext& ctx)
+{
+	// Values up to 8 words live inline. These cross that boundary in both directions.
+	const BigInteger max256 = (BigInteger(1) << 256) - 1;
+	Report(ctx, max256.ToString() == String(PHANTASMA_LITERAL("115792089237316195423570985008687907853269984665640564039457584007913129639935")), "BigInt inline 256-bit max");
+	Report(ctx, max256.ToUintArray().size() == 8, "BigInt inline 256-bit word count");
+
+	const BigInteger carried = max256 + 1;
+	Report(ctx, carried.ToString() == String(PHANTASMA_LITERAL("115792089237316195423570985008687907853269984665640564039457584007913129639936")), "BigInt spill on carry");
+	Report(ctx, carried.ToUintArray().size() == 9, "BigInt spill word count");
+	Report(ctx, carried - 1 == max256, "BigInt spill back to inline");
+
+	const BigInteger squared = max256 * max256;
+	Report(ctx, squared.ToString() == String(PHANTASMA_LITERAL("13407807929942597099574024998205846127479365820592393377723561443721764030073315392623399665776056285720014482370779510884422601683867654778417822746804225")), "BigInt spill mul");
+	Report(ctx, squared / carried == max256 - 1, "BigInt spill div");
+	Report(ctx, squared % ((BigInteger(1) << 255) + 7) == 225, "BigInt spill mod");
+	Report(ctx, ((BigInteger(1) << 300) - (BigInteger(1) << 200)).ToString() == String(PHANTASMA_LITERAL("2037035976334486086268445688407771223007209403390394288543799286751859096769553913348096000")), "BigInt spill shift");
+
+	// Copies and moves between inline and spilled values
+	BigInteger small(42);
+	BigInteger large = squared;
+	Report(ctx, large == squared, "BigInt spilled copy");
+	large = small;
+	Report(ctx, large == 42, "BigInt assign inline over spilled");
+	large = squared;
+	small = std::move(large);
+	Report(ctx, small == squared, "BigInt move spilled");
+	large = BigInteger(7);
+	Report(ctx, large == 7, "BigInt reuse moved-from");
+	BigInteger moved(std::move(small));
+	Report(ctx, moved == squared, "BigInt move construct spilled");
+	moved = moved;
+	Report(ctx, moved == squared, "BigInt self assign spilled");
+
+	const SecureBigInteger secureMax = (SecureBigInteger(1) << 256) - 1;
+	const SecureBigInteger secureSquared = secureMax * secureMax;
+	Report(ctx, secureSquared.ToString() == squared.ToString(), "SecureBigInt spill mul");
+	Report(ctx, secureSquared / secureMax == secureMax, "SecureBigInt spill div");
+	SecureBigInteger secureCopy = secureSquared;
+	secureCopy = SecureBigInteger(5);
+	Report(ctx, secureCopy.ToString() == String(PHANTASMA_LITERAL("5")), "SecureBigInt assign inline over spilled");
+	SecureBigInteger secureMoved = secureSquared;
+	SecureBigInteger secureTarget = secureMax;
+	secureTarget = std::move(secureMoved);
+	secureMoved = SecureBigInteger(3);
+	Report(ctx, secureTarget.ToString() == squared.ToString() && secureMoved.ToString() == String(PHANTASMA_LITERAL("3")), "SecureBigInt move spilled");
+
+	// The heap pointer shares the inline words, so a value is not much bigger than its 256 inline bits
+	Report(ctx, sizeof(BigInteger) <= 48 && sizeof(SecureBigInteger) <= 48, "BigInt inline storage size");
+}
+
+void RunBigIntWideArithmeticTests(TestContext& ctx)
+{
+	// Operands on both sides of the Karatsuba thresholds, checked against the schoolbook division and
+	// against plain square-and-reduce loops
+	UInt64 state = 0x9E3779B97F4A7C15ULL;
+	auto next = [&state]()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return (UInt32)state;
+	};
+	auto random = [&next](int words, int sign)
+	{
+		PHANTASMA_VECTOR<UInt32> w((size_t)words);
+		for( auto& word : w )
+			word = next();
+		w.back() |= 1;
+		return BigInteger(w, sign);
+	};
+
+	const int sizes[] = { 1, 5, 31, 32, 33, 47, 48, 49, 70, 130, 300 };
+	bool products = true;
+	bool squares = true;
+	for( int x : sizes )
+	{
+		for( int y : sizes )
+		{
+			const BigInteger a = random(x, (x + y) % 3 == 0 ? -1 : 1);
+			const BigInteger b = random(y, 1);
+			const BigInteger product = a * b;
+			products &= product / b == a && product % b == 0;
+			const BigInteger copy = a;
+			const BigInteger square = a * a;
+			squares &= square == a * copy && square.GetBitLength() >= 2 * a.GetBitLength() - 1;
+			const BigInteger sum = a + b;
+			squares &= sum * sum == square + a * b * 2 + b * b;
+		}
+	}
+	Report(ctx, products, "BigInt wide multiply divides back");
+	Report(ctx, squares, "BigInt wide square matches multiply");
+
+	const BigInteger base = random(3, 1);
+	BigInteger repeated = BigInteger::One();
+	for( int i = 0; i < 37; ++i )
+		repeated *= base;
+	Report(ctx, BigInteger::Pow(base, 37) == repeated, "BigInt Pow matches repeated multiply");
+	Report(ctx, BigInteger::Pow(-base, 37) == -repeated, "BigInt Pow negative odd");
+
+	bool modPows = true;
+	for( int i = 0; i < 12; ++i )
+	{
+		BigInteger mod = random(1 + i * 3, 1);
+		if( i % 2 )
+			mod += 1; // even moduli take the non-Montgomery path
+		const BigInteger value = random(2 + i, i % 3 == 0 ? -1 : 1);
+		const BigInteger exp = random(1 + i % 3, 1);
+
+		BigInteger expected = BigInteger::One();
+		BigInteger square = BigInteger::Abs(value) % mod;
+		for( int bit = 0; bit < exp.GetBitLength(); ++bit )
+		{
+			if( exp.TestBit(bit) )
+				expected = (expected * square) % mod;
+			square = (square * square) % mod;
+		}
+		if( value.IsNegative() && exp.TestBit(0) )
+			expected = -expected;
+		modPows &= value.ModPow(exp, mod) == expected;
+	}
+	Report(ctx, modPows, "BigInt wide ModPow matches square-and-reduce");
+	Report(ctx, BigInteger(7).ModPow(0, 1) == 1 && BigInteger(7).ModPow(5, 1) == 0, "BigInt ModPow modulus one");
+}
+
+void RunBigIntLongRadixConversionTests(TestContext& ctx)
+{
+	// Long enough to take the split paths in both directions
+	const String nines(1500, '9');
+	const BigInteger ninesValue = BigInteger::Pow(10, 1500) - 1;
+	Report(ctx, ninesValue.ToString() == nines, "BigInt long format nines");
+	Report(ctx, BigInteger::Parse(nines) == ninesValue, "BigInt long parse nines");
+
+	const String padded = String(PHANTASMA_LITERAL("1")) + String(1795, '0') + String(PHANTASMA_LITERAL("12345"));
+	const BigInteger paddedValue = BigInteger::Pow(10, 1800) + 12345;
+	Report(ctx, paddedValue.ToString() == padded, "BigInt long format inner zeros");
+	Report(ctx, BigInteger::Parse(padded) == paddedValue, "BigInt long parse inner zeros");
+	Report(ctx, (-paddedValue).ToString() == String(PHANTASMA_LITERAL("-")) + padded, "BigInt long format negative");
+	Report(ctx, BigInteger::Parse(String(PHANTASMA_LITERAL("-")) + padded) == -paddedValue, "BigInt long parse negative");
+
+	const BigInteger power = BigInteger::Pow(7, 5000);
+	const String powerText = power.ToString();
+	Report(ctx, powerText.length() == 4226 && powerText.substr(0, 6) == String(PHANTASMA_LITERAL("309171")), "BigInt long format digits");
+	Report(ctx, BigInteger::Parse(powerText) == power, "BigInt long decimal roundtrip");
+	Report(ctx, BigInteger::FromHex(power.ToHex()) == power, "BigInt long hex roundtrip");
+	Report(ctx, BigInteger::Parse(powerText + String(PHANTASMA_LITERAL("0"))) == power * 10, "BigInt long parse scaled");
+}
+
+void RunBigIntInPlaceArithmeticTests(TestContext& ctx)
+{
+	const Int64 samples[] = { 0, 1, -1, 7, -7, 100, -100, 0x7FFFFFFFLL, -0x80000000LL, 0xFFFFFFFFLL, -0xFFFFFFFFLL };
+	bool sumsMatch = true;
+	bool differencesMatch = true;
+	for( Int64 x : samples )
+	{
+		for( Int64 y : samples )
+		{
+			BigInteger a(x);
+			a += BigInteger(y);
+			sumsMatch &= a == BigInteger(x + y) && a.ToString() == BigInteger(x + y).ToString();
+			BigInteger b(x);
+			b -= BigInteger(y);
+			differencesMatch &= b == BigInteger(x - y) && b.ToString() == BigInteger(x - y).ToString();
+		}
+	}
+	Report(ctx, sumsMatch, "BigInt += sign grid");
+	Report(ctx, differencesMatch, "BigInt -= sign grid");
+
+	BigInteger self = BigInteger::Parse(String(PHANTASMA_LITERAL("123456789012345678901234567890")));
+	self += self;
+	Report(ctx, self == BigInteger::Parse(String(PHANTASMA_LITERAL("246913578024691357802469135780"))), "BigInt += self");
+	self -= self;
+	Report(ctx, self.IsZero() && self == BigInteger::Zero(), "BigInt -= self");
+
+	// Carries and borrows across spilled storage
+	const BigInteger big = BigInteger::Pow(2, 700);
+	BigInteger acc = big - 1;
+	acc += 1;
+	Report(ctx, acc == big, "BigInt += carry past inline words");
+	acc -= 1;
+	Report(ctx, acc == big - 1 && acc.GetBitLength() == 700, "BigInt -= borrow shrinks");
+	acc = BigInteger(5);
+	acc -= big;
+	Report(ctx, acc == -(big - 5), "BigInt -= larger subtrahend");
+	acc += big * 2;
+	Report(ctx, acc == big + 5, "BigInt += flips sign");
+
+	// Rvalue chains match the lvalue forms
+	const BigInteger x = BigInteger::Pow(3, 200);
+	const BigInteger y = BigInteger::Pow(5, 120);
+	const BigInteger chained = (x + y) + (x - y) - (y - x) + BigInteger(7) - (x * 2);
+	const BigInteger twoX = x * 2;
+	Report(ctx, chained == x - y + 7 && chained + twoX == x + x + x - y + 7, "BigInt rvalue chain");
+	Report(ctx, BigInteger(3) - (y + 1) == -(y - 2), "BigInt rvalue right operand");
+	Report(ctx, BigInteger(3) / BigInteger(5) == 0, "BigInt short quotient normalized");
+
+	// One scratch and one quot/rem pair reused across mixed sizes
+	BigInteger::DivisionScratch scratch;
+	BigInteger quot, rem;
+	bool divisionsMatch = true;
+	for( int i = 1; i < 40; i++ )
+	{
+		const BigInteger a = BigInteger::Pow(7, i * 9) + i;
+		const BigInteger b = BigInteger::Pow(3, i * 2) + 1;
+		BigInteger::DivideAndModulus(a, b, quot, rem, scratch);
+		divisionsMatch &= quot == a / b && rem == a % b && quot * b + rem == a;
+		BigInteger::DivideAndModulus(-a, b, quot, rem, scratch);
+		BigInteger expectedQuot, expectedRem;
+		BigInteger::DivideAndModulus(-a, b, expectedQuot, expectedRem);
+		divisionsMatch &= quot == expectedQuot && rem == expectedRem;
+	}
+	Report(ctx, divisionsMatch, "BigInt DivideAndModulus with reused scratch");
+
+	BigInteger dividend = BigInteger::Pow(10, 60) + 17;
+	const BigInteger divisor = BigInteger::Pow(10, 30);
+	BigInteger::DivideAndModulus(dividend, divisor, dividend, rem, scratch);
+	Report(ctx, dividend == divisor && rem == 17, "BigInt DivideAndModulus quotient aliases dividend");
+	BigInteger d = BigInteger::Pow(2, 100) + 3;
+	BigInteger::DivideAndModulus(d, d, quot, d, scratch);
+	Report(ctx, quot == 1 && d.IsZero(), "BigInt DivideAndModulus remainder aliases both");
+
+	// Compound operators on a spilled accumulator work in its own storage. The first pass grows it; later ones
+	// reuse that capacity.
+	const BigInteger start = BigInteger::Pow(7, 90);
+	const BigInteger factor = BigInteger::Pow(3, 20);
+	const BigInteger modulus = BigInteger::Pow(2, 400) + 1;
+	BigInteger accumulator;
+	int allocations = 0;
+	for( int pass = 0; pass < 3; pass++ )
+	{
+		g_allocations = 0;
+		g_countAllocations = pass > 0;
+		accumulator = start;
+		accumulator *= factor;
+		accumulator *= accumulator;
+		accumulator /= factor;
+		accumulator %= modulus;
+		accumulator *= -1;
+		accumulator %= factor;
+		g_countAllocations = false;
+		allocations += g_allocations;
+	}
+	const BigInteger squared = (start * factor) * (start * factor);
+	const BigInteger expected = -(squared / factor % modulus) % factor;
+	Report(ctx, allocations == 0 && accumulator == expected && !expected.IsZero(), "BigInt compound operators stay in place", std::to_string(allocations));
+	accumulator /= accumulator;
+	Report(ctx, accumulator == 1, "BigInt /= self");
+	accumulator = expected;
+	accumulator %= accumulator;
+	Report(ctx, accumulator.IsZero(), "BigInt %= self");
+
+	BigInteger counter = BigInteger::Pow(2, 64) - 1;
+	++counter;
+	Report(ctx, counter == BigInteger::Pow(2, 64), "BigInt increment carries");
+	counter--;
+	Report(ctx, counter == BigInteger::Pow(2, 64) - 1, "BigInt decrement borrows");
+}
+
 } // namespace testcases
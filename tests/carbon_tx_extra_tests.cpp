@@ -66,6 +66,32 @@ void RunCarbonTxExtraTests(TestContext& ctx)
 		Report(ctx, got == expected, "TxMsg MintFungible vector", got + " vs " + expected);
 	}
 
+	{
+		Blockchain::TxMsg msg;
+		msg.type = Blockchain::TxTypes::TransferFungible;
+		msg.expiry = expiry;
+		msg.maxGas = maxGas;
+		msg.maxData = maxData;
+		msg.gasFrom = senderPub;
+		msg.payload = payload;
+		msg.transferFt = Blockchain::TxMsgTransferFungible{ receiverPub, 1, 100000000 };
+
+		const ByteArray serialized = Blockchain::SerializeTx(msg);
+		Report(ctx, CarbonSerializedSize(msg) == serialized.size(), "CarbonSerializedSize matches serialized TxMsg");
+
+		const Ed25519Signature sig = Ed25519Signature::Generate(sender, serialized);
+		Witness witness{ senderPub, Bytes64(sig.Bytes(), Ed25519Signature::Length) };
+		Blockchain::SignedTxMsg signedMsg;
+		signedMsg.msg = msg;
+		signedMsg.witnesses = Witnesses{ 1, &witness };
+		ByteArray expected;
+		WriteView w(expected);
+		Write(signedMsg, w);
+
+		const ByteArray got = Blockchain::TxMsgSigner::SignAndSerialize(msg, sender);
+		Report(ctx, got == expected && got.capacity() == got.size(), "TxMsgSigner::SignAndSerialize writes into an exactly-sized buffer", BytesToHex(got) + " vs " + BytesToHex(expected));
+	}
+
 	ExpectThrowContains(ctx, "MintPhantasmaNonFungibleTxHelper rejects null tokens pointer", "tokens is required", [&]()
 	    { (void)MintPhantasmaNonFungibleTxHelper::BuildTx(
 		      42,
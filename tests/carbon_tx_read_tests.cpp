@@ -0,0 +1,263 @@
+#include "test_cases.h"
+
+namespace testcases {
+using namespace testutil;
+
+namespace {
+
+struct TxSample {
+	const char* name;
+	Blockchain::TxMsg msg;
+};
+
+bool Within(const ByteView& inner, const ByteArray& outer)
+{
+	return inner.length && inner.bytes >= outer.data() && inner.bytes + inner.length <= outer.data() + outer.size();
+}
+
+} // namespace
+
+void RunCarbonTxReadTests(TestContext& ctx)
+{
+	Bytes32 gasFrom;
+	Bytes32 from;
+	Bytes32 to;
+	for( int i = 0; i != 32; ++i )
+	{
+		gasFrom.bytes[i] = (uint8_t)(0x10 + i);
+		from.bytes[i] = (uint8_t)(0x40 + i);
+		to.bytes[i] = (uint8_t)(0x80 + i);
+	}
+	const ByteArray args = HexToBytes("0102030405");
+	const ByteArray rom = HexToBytes("0A0B0C0D");
+	const ByteArray ram = HexToBytes("EE");
+	const uint64_t instanceIds[3] = { 7, 8, 0xFFFFFFFFFFFFFFFFULL };
+	const intx amount = ParseIntx("123456789012345678901234567890");
+
+	Blockchain::TxMsgCall calls[2]{};
+	calls[0].moduleId = 1;
+	calls[0].methodId = 2;
+	calls[0].args = ByteView{ args.data(), args.size() };
+	calls[1].moduleId = 3;
+	calls[1].methodId = 4;
+
+	Blockchain::TxMsgTransferFungible_GasPayer tradeTransferF[1] = { { to, from, 1, 500 } };
+	Blockchain::TxMsgTransferNonFungible_Single_GasPayer tradeTransferN[2] = { { to, from, 2, 9 }, { from, to, 2, 10 } };
+	Blockchain::TxMsgMintNonFungible tradeMintN[1] = { { 5, to, 6, ByteView{ rom.data(), rom.size() }, ByteView{ ram.data(), ram.size() } } };
+	Blockchain::TxMsgBurnNonFungible_GasPayer tradeBurnN[1] = { { 5, from, 11 } };
+
+	std::vector<TxSample> samples;
+	auto add = [&](const char* name, Blockchain::TxTypes type) -> Blockchain::TxMsg&
+	{
+		samples.push_back(TxSample{ name, Blockchain::TxMsg() });
+		Blockchain::TxMsg& msg = samples.back().msg;
+		msg.type = type;
+		msg.expiry = 1759711416000LL;
+		msg.maxGas = 10000000;
+		msg.maxData = 1000;
+		msg.gasFrom = gasFrom;
+		msg.payload = SmallString("read-tests");
+		return msg;
+	};
+	add("Call", Blockchain::TxTypes::Call).call = calls[0];
+	add("Call_Multi", Blockchain::TxTypes::Call_Multi).callMulti = Blockchain::TxMsgCall_Multi{ 2, calls };
+	{
+		Blockchain::TxMsgTrade trade{};
+		trade.numTransferF = 1;
+		trade.transferF = tradeTransferF;
+		trade.numTransferN = 2;
+		trade.transferN = tradeTransferN;
+		trade.numMintN = 1;
+		trade.mintN = tradeMintN;
+		trade.numBurnN = 1;
+		trade.burnN = tradeBurnN;
+		add("Trade", Blockchain::TxTypes::Trade).trade = trade;
+	}
+	add("TransferFungible", Blockchain::TxTypes::TransferFungible).transferFt = { to, 1, 100000000 };
+	add("TransferFungible_GasPayer", Blockchain::TxTypes::TransferFungible_GasPayer).transferFtGasPayer = { to, from, 1, 100000000 };
+	add("TransferNonFungible_Single", Blockchain::TxTypes::TransferNonFungible_Single).transferNftSingle = { to, 2, 42 };
+	add("TransferNonFungible_Single_GasPayer", Blockchain::TxTypes::TransferNonFungible_Single_GasPayer).transferNftSingleGasPayer = { to, from, 2, 42 };
+	add("TransferNonFungible_Multi", Blockchain::TxTypes::TransferNonFungible_Multi).transferNftMulti = { to, 2, 3, instanceIds };
+	add("TransferNonFungible_Multi_GasPayer", Blockchain::TxTypes::TransferNonFungible_Multi_GasPayer).transferNftMultiGasPayer = { to, from, 2, 3, instanceIds };
+	add("MintFungible", Blockchain::TxTypes::MintFungible).mintFungible = { 1, (const intx_pod&)amount, to };
+	add("BurnFungible", Blockchain::TxTypes::BurnFungible).burnFungible = { 1, (const intx_pod&)amount };
+	add("BurnFungible_GasPayer", Blockchain::TxTypes::BurnFungible_GasPayer).burnFungibleGasPayer = { 1, (const intx_pod&)amount, from };
+	add("MintNonFungible", Blockchain::TxTypes::MintNonFungible).mintNonFungible = tradeMintN[0];
+	add("BurnNonFungible", Blockchain::TxTypes::BurnNonFungible).burnNonFungible = { 5, 11 };
+	add("BurnNonFungible_GasPayer", Blockchain::TxTypes::BurnNonFungible_GasPayer).burnNonFungibleGasPayer = { 5, from, 11 };
+	add("Phantasma", Blockchain::TxTypes::Phantasma).phantasma = { SmallString("mainnet"), SmallString("main"), ByteView{ args.data(), args.size() } };
+	add("Phantasma_Raw", Blockchain::TxTypes::Phantasma_Raw).phantasmaRaw = { ByteView{ rom.data(), rom.size() } };
+
+	Witness witnesses[2];
+	witnesses[0].address = gasFrom;
+	witnesses[1].address = from;
+	for( int i = 0; i != 64; ++i )
+	{
+		witnesses[0].signature.bytes[i] = (uint8_t)i;
+		witnesses[1].signature.bytes[i] = (uint8_t)(0xFF - i);
+	}
+
+	std::vector<ByteArray> encodedSamples;
+	for( const TxSample& sample : samples )
+	{
+		Blockchain::SignedTxMsg signedMsg;
+		signedMsg.msg = sample.msg;
+		if( sample.msg.type == Blockchain::TxTypes::Phantasma_Raw )
+			signedMsg.witnesses = Witnesses{ 0, nullptr };
+		else if( Blockchain::GasPayerSender(sample.msg) || sample.msg.type == Blockchain::TxTypes::Call_Multi )
+			signedMsg.witnesses = Witnesses{ 2, witnesses };
+		else
+			signedMsg.witnesses = Witnesses{ 1, witnesses };
+		const ByteArray encoded = CarbonSerialize(signedMsg);
+		encodedSamples.push_back(encoded);
+		const std::string name = std::string("SignedTxMsg Read ") + sample.name;
+
+		for( int inPlace = 0; inPlace != 2; ++inPlace )
+		{
+			Allocator alloc;
+			ReadView r(encoded, alloc, inPlace ? ReadView::InPlace : ReadView::Copy);
+			Blockchain::SignedTxMsg decoded;
+			const bool ok = Read(decoded, r, alloc) && r.Finished();
+			const bool same = ok && CarbonSerialize(decoded) == encoded &&
+			                  decoded.witnesses.numWitnesses == signedMsg.witnesses.numWitnesses &&
+			                  (!decoded.witnesses.numWitnesses || decoded.witnesses.witnesses[0] == witnesses[0]);
+			Report(ctx, same, name + (inPlace ? " (in-place)" : " (copy)"));
+
+			if( ok && sample.msg.type == Blockchain::TxTypes::MintNonFungible )
+			{
+				const ByteView decodedRom = decoded.msg.mintNonFungible.rom;
+				Report(ctx, Within(decodedRom, encoded) == !!inPlace && alloc.Dbg_IsOwner(decodedRom.bytes) == !inPlace, name + " payload placement");
+			}
+		}
+	}
+
+	{
+		Blockchain::SignedTxMsg signedMsg;
+		signedMsg.msg = samples[3].msg;
+		signedMsg.witnesses = Witnesses{ 1, witnesses };
+		ByteArray encoded = CarbonSerialize(signedMsg);
+		encoded.pop_back();
+		Allocator alloc;
+		ReadView r(encoded, alloc, ReadView::InPlace);
+		Blockchain::SignedTxMsg decoded;
+		bool ok = false;
+		PHANTASMA_TRY
+		{
+			ok = Read(decoded, r, alloc);
+		}
+		PHANTASMA_CATCH_ALL()
+		{
+		}
+		Report(ctx, !ok, "SignedTxMsg Read rejects truncated input");
+	}
+
+	{
+		const size_t count = 300;
+		ByteArray batch;
+		WriteView w(batch);
+		for( size_t i = 0; i != count; ++i )
+			Blockchain::WriteTxBatchEntry(View(encodedSamples[i % encodedSamples.size()]), w);
+
+		std::vector<ByteView> entries;
+		Report(ctx, Blockchain::SplitTxBatch(View(batch), entries) && entries.size() == count, "SplitTxBatch finds every entry");
+		Report(ctx, !Blockchain::SplitTxBatch(View(batch), entries, count - 1) && entries.empty(), "SplitTxBatch enforces the transaction limit");
+
+		for( uint32_t threads = 1; threads <= 4; threads += 3 )
+		{
+			Blockchain::TxBatchDecoder decoder(threads);
+			for( int inPlace = 0; inPlace != 2; ++inPlace )
+			{
+				std::vector<Blockchain::DecodedTx> results;
+				bool ok = decoder.Decode(View(batch), results, inPlace ? ReadView::InPlace : ReadView::Copy) && results.size() == count;
+				for( size_t i = 0; ok && i != count; ++i )
+					ok = results[i].ok && CarbonSerialize(results[i].tx) == encodedSamples[i % encodedSamples.size()];
+				Report(ctx, ok, std::string("TxBatchDecoder preserves order with ") + std::to_string(threads) + " thread(s)" + (inPlace ? " (in-place)" : " (copy)"));
+			}
+		}
+
+		Blockchain::TxBatchDecoder decoder(4);
+		ByteArray corrupt;
+		WriteView cw(corrupt);
+		for( size_t i = 0; i != 40; ++i )
+		{
+			ByteArray encoded = encodedSamples[i % encodedSamples.size()];
+			if( i == 25 )
+				encoded.pop_back();
+			Blockchain::WriteTxBatchEntry(View(encoded), cw);
+		}
+		std::vector<Blockchain::DecodedTx> results;
+		const bool ok = decoder.Decode(View(corrupt), results);
+		bool othersOk = results.size() == 40;
+		for( size_t i = 0; othersOk && i != results.size(); ++i )
+			othersOk = results[i].ok == (i != 25);
+		Report(ctx, !ok && othersOk, "TxBatchDecoder flags only the malformed transaction");
+
+		corrupt.pop_back();
+		Report(ctx, !decoder.Decode(View(corrupt), results) && results.empty(), "TxBatchDecoder rejects broken framing");
+
+		// A call whose witness list claims far more entries than the input holds
+		ByteArray forged;
+		for( const TxSample& sample : samples )
+		{
+			if( sample.msg.type == Blockchain::TxTypes::Call )
+			{
+				forged = CarbonSerialize(sample.msg);
+				const ByteArray hugeCount = HexToBytes("0000007F");
+				forged.insert(forged.end(), hugeCount.begin(), hugeCount.end());
+			}
+		}
+		ByteArray withForged;
+		WriteView fw(withForged);
+		for( size_t i = 0; i != 40; ++i )
+			Blockchain::WriteTxBatchEntry(i == 13 ? View(forged) : View(encodedSamples[i % encodedSamples.size()]), fw);
+		const bool forgedOk = !forged.empty() && !decoder.Decode(View(withForged), results) && results.size() == 40;
+		bool othersDecoded = forgedOk;
+		for( size_t i = 0; othersDecoded && i != results.size(); ++i )
+			othersDecoded = results[i].ok == (i != 13);
+		Report(ctx, othersDecoded, "TxBatchDecoder flags an entry with a forged count");
+	}
+	{
+		// Counts that the rest of the input cannot hold fail before anything is allocated
+		const auto rejected = [](const char* hex, auto read)
+		{
+			Allocator alloc;
+			const ByteArray input = HexToBytes(hex);
+			ReadView r(input, alloc, ReadView::InPlace);
+			const AllocatorCheckpoint before = alloc.Checkpoint();
+			uint8_t* expected = alloc.Alloc<uint8_t>(1);
+			alloc.RewindTo(before);
+			bool ok = true;
+			PHANTASMA_TRY
+			{
+				ok = read(r, alloc);
+			}
+			PHANTASMA_CATCH_ALL()
+			{
+			}
+			return !ok && expected == alloc.Alloc<uint8_t>(1);
+		};
+		const auto readWitnesses = [](ReadView& r, Allocator& alloc)
+		{
+			Witnesses decoded{};
+			return Blockchain::Read(decoded, r, alloc);
+		};
+		const auto readSections = [](ReadView& r, Allocator& alloc)
+		{
+			Blockchain::MsgCallArgSections sections{};
+			return Read(sections, r, alloc);
+		};
+		const auto readBytesArray = [](ReadView& r, Allocator& alloc)
+		{
+			uint32_t length = 0;
+			ByteView* items = nullptr;
+			return ReadArray(length, items, r, alloc);
+		};
+		Report(ctx, rejected("0000007F", readWitnesses) && rejected("00000001", readWitnesses) &&
+		                rejected("01000000" "00112233445566778899AABBCCDDEEFF00112233445566778899AABBCCDDEEFF", readWitnesses),
+		    "Witness count larger than the input is rejected");
+		Report(ctx, rejected("00000080", readSections) && rejected("FFFFFF8000000000", readSections), "Arg section count larger than the input is rejected");
+		Report(ctx, rejected("FFFFFF7F00000000", readBytesArray), "Byte array count larger than the input is rejected");
+	}
+}
+
+} // namespace testcases
@@ -1,5 +1,8 @@
 #include "test_cases.h"
 
+#include <atomic>
+#include <thread>
+
 namespace testcases {
 using namespace testutil;
 
@@ -30,6 +33,205 @@ void RunKeyPairTests(TestContext& ctx)
 	Report(ctx, !badOk, "Ed25519 signature mismatch");
 	Report(ctx, sig.VerifyIndex(badMessage.data(), (int)badMessage.size(), addresses, 1) == -1, "Ed25519 signature mismatch index");
 	Report(ctx, wrapped.VerifyIndex(badMessage.data(), (int)badMessage.size(), addresses, 1) == -1, "Signature mismatch index");
+
+	{
+		// Signing through the key's cached context gives the same signatures as expanding the key every time, also for
+		// copies of the key and from several threads at once
+		Byte expanded[64];
+		{
+			SecureByteReader read = keys.GetPrivateKey().Read();
+			Ed25519::ExpandedPrivateKeyFromSeed(expanded, 64, read.Bytes(), 32);
+		}
+		PhantasmaKeys assigned;
+		assigned = keys;
+		std::atomic<bool> signerOk{ true };
+		std::vector<std::thread> signers;
+		for( int t = 0; t < 3; ++t )
+		{
+			signers.emplace_back([&, t]()
+			    {
+				    const PhantasmaKeys copy(keys);
+				    for( int i = 1; i < 40; ++i )
+				    {
+					    const ByteArray part(i, (Byte)t);
+					    const Ed25519Signature expected(Ed25519::Sign(part.data(), i, expanded, 64));
+					    const bool ok = copy.Sign(part) == expected && assigned.Sign(part) == expected;
+					    if( !ok )
+						    signerOk = false;
+				    }
+			    });
+		}
+		for( std::thread& signer : signers )
+			signer.join();
+		Report(ctx, signerOk && keys.Sign(message) == sig, "Ed25519 cached signing context");
+	}
+
+	{
+		// More distinct keys than the OpenSSL adapter keeps decoded, revisited out of order
+		const int count = 40;
+		const int numKeys = 10;
+		Byte expanded[numKeys][64];
+		for( int k = 0; k < numKeys; ++k )
+		{
+			Byte seed[32];
+			for( int j = 0; j < 32; ++j )
+				seed[j] = (Byte)(k * 29 + j);
+			Ed25519::ExpandedPrivateKeyFromSeed(expanded[k], 64, seed, 32);
+		}
+		std::vector<ByteArray> messages(count), signatures(count);
+		std::vector<const Byte*> messagePtrs(count), signaturePtrs(count), keyPtrs(count);
+		std::vector<int> lengths(count);
+		for( int i = 0; i < count; ++i )
+		{
+			const int k = (i * 7) % numKeys;
+			messages[i].assign(message.begin(), message.end());
+			messages[i].push_back((Byte)i);
+			signatures[i] = Ed25519::Sign(messages[i].data(), (int)messages[i].size(), expanded[k], 64);
+			messagePtrs[i] = messages[i].data();
+			lengths[i] = (int)messages[i].size();
+			signaturePtrs[i] = signatures[i].data();
+			keyPtrs[i] = expanded[k] + 32;
+		}
+		bool results[count];
+		const bool allOk = Ed25519::VerifyBatch(messagePtrs.data(), lengths.data(), signaturePtrs.data(), keyPtrs.data(), count, results);
+		bool each = allOk;
+		for( int i = 0; i < count; ++i )
+			each &= results[i];
+		Report(ctx, each, "Ed25519 batch verify");
+
+		signatures[3][10] ^= 1;
+		messages[17].back() ^= 1;
+		keyPtrs[31] = expanded[(31 * 7 + 1) % numKeys] + 32;
+		const bool badBatch = Ed25519::VerifyBatch(messagePtrs.data(), lengths.data(), signaturePtrs.data(), keyPtrs.data(), count, results);
+		bool pinpointed = !badBatch;
+		for( int i = 0; i < count; ++i )
+			pinpointed &= results[i] == (i != 3 && i != 17 && i != 31);
+		Report(ctx, pinpointed, "Ed25519 batch verify reports each bad signature");
+		Report(ctx, !Ed25519::VerifyBatch(messagePtrs.data(), lengths.data(), signaturePtrs.data(), keyPtrs.data(), count),
+		    "Ed25519 batch verify without per-entry results");
+	}
+	{
+		// Pieces that straddle block boundaries, and a hash in progress carried between the adapter and the built-in code
+		ByteArray data(300);
+		for( size_t i = 0; i != data.size(); ++i )
+			data[i] = (Byte)(i * 13 + 1);
+		bool streamOk = true;
+		bool midstateOk = true;
+		for( int length = 1; length <= (int)data.size(); length += 7 )
+		{
+			const ByteArray part(data.begin(), data.begin() + length);
+			const ByteArray expected = SHA256(part);
+			SHA256Hasher hasher;
+			for( int i = 0; i < length; i += 37 )
+				hasher.Update(data.data() + i, PHANTASMA_MIN(37, length - i));
+			streamOk &= hasher.Final() == expected;
+
+			const int split = length / 2;
+			hasher.Update(data.data(), split);
+			Sha256::Midstate midstate;
+			hasher.Export(midstate);
+			Sha256::Update(midstate, data.data() + split, (size_t)(length - split));
+			Byte builtIn[Sha256::DigestLength];
+			Sha256::Final(midstate, builtIn);
+			midstateOk &= ByteArray(builtIn, builtIn + Sha256::DigestLength) == expected;
+
+			Sha256::Init(midstate);
+			Sha256::Update(midstate, data.data(), (size_t)split);
+			SHA256Hasher resumed;
+			resumed.Import(midstate);
+			resumed.Update(data.data() + split, length - split);
+			midstateOk &= resumed.Final() == expected;
+		}
+		Report(ctx, streamOk, "SHA256 incremental hash");
+		Report(ctx, midstateOk, "SHA256 midstate export and import");
+
+		// Every kernel this CPU can run, against the adapter, for lengths around each padding boundary
+		const char abcText[] = "abc";
+		const ByteArray abc((const Byte*)abcText, (const Byte*)abcText + 3);
+		bool kernelsOk = ToUpper(BytesToHex(SHA256(abc))) == "BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD";
+		const int count = 150;
+		std::vector<const Byte*> inputs(count);
+		std::vector<int> inputLengths(count);
+		std::vector<size_t> sizes(count);
+		std::vector<ByteArray> pieces(count);
+		std::vector<Byte> expected(count * Sha256::DigestLength);
+		for( int i = 0; i < count; ++i )
+		{
+			inputLengths[i] = i < 140 ? i : 64 * i;
+			pieces[i].assign(data.begin(), data.begin() + PHANTASMA_MIN(inputLengths[i], (int)data.size()));
+			pieces[i].resize(inputLengths[i], (Byte)i);
+			inputs[i] = pieces[i].data();
+			sizes[i] = (size_t)inputLengths[i];
+			Byte* digest = &expected[i * Sha256::DigestLength];
+			if( i )
+				PHANTASMA_SHA256(digest, Sha256::DigestLength, inputs[i], inputLengths[i]);
+			else
+				Sha256::Hash(digest, inputs[i], 0);
+
+			Byte actual[Sha256::DigestLength];
+			Sha256::Hash(actual, inputs[i], sizes[i]);
+			kernelsOk &= PHANTASMA_EQUAL(actual, actual + Sha256::DigestLength, digest);
+			UInt32 state[Sha256::StateWords];
+			Sha256::Init(state);
+			Byte tail[2 * Sha256::BlockLength];
+			const size_t whole = sizes[i] / Sha256::BlockLength;
+			Sha256::CompressScalar(state, inputs[i], whole);
+			PHANTASMA_COPY(inputs[i] + whole * Sha256::BlockLength, inputs[i] + sizes[i], tail);
+			Sha256::CompressScalar(state, tail, (size_t)Sha256::Pad(tail, inputLengths[i] % Sha256::BlockLength, sizes[i]));
+			Sha256::StoreDigest(actual, state);
+			kernelsOk &= PHANTASMA_EQUAL(actual, actual + Sha256::DigestLength, digest);
+		}
+		kernelsOk &= expected[0] == 0xE3 && expected[31] == 0x55;
+		std::vector<Byte> many(count * Sha256::DigestLength);
+		SHA256Many(inputs.data(), inputLengths.data(), many.data(), count);
+		kernelsOk &= many == expected;
+#if defined(PHANTASMA_SIMD_X86)
+		if( Cpu::ActiveIsa() == Cpu::Isa::AVX2 )
+		{
+			// Group sizes that leave lanes unused
+			for( int n : { 1, 5, 8, 13, count } )
+			{
+				std::vector<Byte> lanes(n * Sha256::DigestLength);
+				Sha256::HashMany8(inputs.data() + count - n, sizes.data() + count - n, lanes.data(), (size_t)n);
+				kernelsOk &= PHANTASMA_EQUAL(lanes.begin(), lanes.end(), expected.end() - n * Sha256::DigestLength);
+			}
+		}
+#endif
+		Report(ctx, kernelsOk, "SHA256 kernels match the adapter");
+
+		std::vector<Hash> hashes(count);
+		Hash::FromBytesMany(pieces.data(), hashes.data(), count);
+		bool fromBytesOk = true;
+		for( int i = 0; i < count; ++i )
+			fromBytesOk &= hashes[i] == Hash::FromBytes(pieces[i]);
+		Report(ctx, fromBytesOk, "Hash from many byte arrays");
+
+		SHA256Hasher writerHash;
+		BinaryWriter hashingWriter = BinaryWriter::ToSink(writerHash);
+		BinaryWriter bufferedWriter;
+		for( BinaryWriter* w : { &hashingWriter, &bufferedWriter } )
+		{
+			w->WriteVarString(PHANTASMA_LITERAL("main"));
+			w->WriteByteArray(data);
+			w->Write((UInt32)1234567890);
+		}
+		Report(ctx, hashingWriter.Position() == bufferedWriter.Position() && hashingWriter.ToArray().empty() &&
+		                writerHash.Final() == SHA256(bufferedWriter.ToArray()),
+		    "BinaryWriter hashing sink");
+
+		SHA256Hasher viewHash;
+		carbon::WriteView hashingView = carbon::WriteView::ToSink(viewHash);
+		carbon::Bytes viewBytes;
+		carbon::WriteView bufferedView(viewBytes);
+		for( carbon::WriteView* w : { &hashingView, &bufferedView } )
+		{
+			carbon::WriteArray(carbon::ByteView{ data.data(), data.size() }, *w);
+			w->WriteByte(7);
+		}
+		const ByteArray viewCopy(viewBytes.begin(), viewBytes.end());
+		Report(ctx, hashingView.Size() == viewBytes.size() && !hashingView.Counting() && viewHash.Final() == SHA256(viewCopy),
+		    "WriteView hashing sink");
+	}
 }
 
 } // namespace testcases
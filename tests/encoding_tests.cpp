@@ -15,16 +15,149 @@ void RunEncodingRoundtripTests(TestContext& ctx)
 		const ByteArray decoded = Base16::Decode(hex.c_str(), (int)hex.size());
 		Report(ctx, decoded == data, "Base16 roundtrip");
 	}
+	{
+		// Lengths around the 16 and 32 byte blocks of the vector kernels, against the scalar conversion
+		bool encodeOk = true;
+		bool decodeOk = true;
+		bool invalidOk = true;
+		for( int length = 1; length <= 100; ++length )
+		{
+			ByteArray bytes(length);
+			for( int i = 0; i < length; ++i )
+				bytes[i] = (Byte)(i * 37 + length);
+			for( bool lowercase : { false, true } )
+			{
+				String expected(length * 2, ' ');
+				Base16::Kernels::EncodeScalar(&expected[0], bytes.data(), length, lowercase);
+				const String encoded = Base16::Encode(bytes.data(), length, lowercase);
+				encodeOk &= encoded == expected;
+				decodeOk &= Base16::Decode(encoded) == bytes;
+			}
+
+			String text = Base16::Encode(bytes.data(), length);
+			const int bad = (length * 7) % (length * 2);
+			text[bad] = 'g';
+			ByteArray out(length);
+			const int decoded = Base16::Decode(out.data(), length, text.c_str(), (int)text.size());
+			invalidOk &= decoded == bad / 2 && !Base16::IsValid(text);
+		}
+		Report(ctx, encodeOk, "Base16 block encode matches scalar");
+		Report(ctx, decodeOk, "Base16 block decode roundtrip");
+		Report(ctx, invalidOk, "Base16 invalid digit stops decoding at its pair");
+		Report(ctx, Base16::IsValid(PHANTASMA_LITERAL("0xaBcDeF0123456789aBcDeF0123456789aBcDeF0123456789aBcDeF0123456789")),
+		    "Base16 mixed case is valid");
+#if defined(PHANTASMA_SIMD_X86)
+		const ByteArray bytes = HexToBytes("00112233445566778899AABBCCDDEEFF0F1E2D3C4B5A69788796A5B4C3D2E1F0");
+		char chars[64];
+		Byte back[32];
+		const bool sse2Ok = Base16::Kernels::EncodeSSE2(chars, bytes.data(), 32, false) == 32 &&
+		                    std::string(chars, 64) == BytesToHex(bytes) &&
+		                    Base16::Kernels::DecodeSSE2(back, chars, 32) == 32 && ByteArray(back, back + 32) == bytes;
+		Report(ctx, sse2Ok, "Base16 SSE2 kernels");
+#endif
+	}
 	{
 		const auto encoded = Base58::Encode(data.empty() ? nullptr : data.data(), (int)data.size());
 		const ByteArray decoded = Base58::Decode(encoded);
 		Report(ctx, decoded == data, "Base58 roundtrip");
 	}
+	{
+		const char* vectors[][2] = {
+			{ "61", "2g" },
+			{ "626262", "a3gV" },
+			{ "73696D706C792061206C6F6E6720737472696E67", "2cFupjhnEsSn59qHXstmK2ffpLv2" },
+			{ "00EB15231DFCEB60925886B67D065299925915AEB172C06647", "1NS17iag9jJgTHD1VXjvLCEnZuQ3rJDE9L" },
+			{ "BF4F89001E670274DD", "3SEo3LWLoPntC" },
+			{ "ECAC89CAD93923C02321", "EJDM8drfXA6uyA" },
+			// A zero value keeps its own digit after the leading zero bytes, as in the C# implementation
+			{ "0000", "111" },
+		};
+		bool ok = true;
+		for( const auto& v : vectors )
+		{
+			const ByteArray bytes = HexToBytes(v[0]);
+			const String encoded = Base58::Encode(bytes.data(), (int)bytes.size());
+			ok &= std::string(encoded.c_str()) == v[1];
+			ok &= v[0] == std::string("0000") || Base58::Decode(encoded) == bytes;
+		}
+		Report(ctx, ok, "Base58 known vectors");
+
+		ByteArray large(600);
+		for( size_t i = 0; i != large.size(); ++i )
+			large[i] = (Byte)(i * 131 + 7);
+		large[0] = large[1] = 0;
+		const String encoded = Base58::Encode(large.data(), (int)large.size());
+		Report(ctx, Base58::Decode(encoded) == large, "Base58 roundtrip beyond the inline scratch");
+
+		Byte fixed[4] = {};
+		Report(ctx, Base58::DecodeFixed<4>(fixed, PHANTASMA_LITERAL("2g"), 2) == 1, "Base58 fixed decode reports short values");
+		ExpectThrowContains(ctx, "Base58 rejects characters outside the alphabet", "invalid character", []
+		    { Base58::Decode(String(PHANTASMA_LITERAL("2g0"))); });
+	}
 	{
 		const auto encoded = Base64::Encode(data);
 		const ByteArray decoded = Base64::Decode(encoded);
 		Report(ctx, decoded == data, "Base64 roundtrip");
 	}
+	{
+		// Lengths around the 24/48 byte blocks of the vector kernels, fed whole and in uneven pieces. Pieces of more than
+		// 64 bytes or characters take the block kernels inside Update; sizes that are not a multiple of a block leave a
+		// different remainder for the scalar tail each time.
+		bool blocksOk = true;
+		bool streamOk = true;
+		for( int length = 1; length <= 400; length += length < 160 ? 1 : 7 )
+		{
+			ByteArray bytes(length);
+			for( int i = 0; i < length; ++i )
+				bytes[i] = (Byte)(i * 53 + length);
+			const String encoded = Base64::Encode(bytes);
+
+			String expected(Base64::RequiredCharacters(length), '=');
+			const int groups = Base64::Kernels::EncodeScalar(&expected[0], bytes.data(), length);
+			blocksOk &= encoded.compare(0, groups / 3 * 4, expected, 0, groups / 3 * 4) == 0;
+			blocksOk &= Base64::Decode(encoded) == bytes;
+
+			for( int piece : { 13, 65, 96, 127 } )
+			{
+				Base64::Encoder encoder;
+				String streamed;
+				std::vector<Char> chars(Base64::Encoder::MaxUpdateCharacters(piece) + Base64::Encoder::MaxFinalCharacters);
+				for( int i = 0; i < length; i += piece )
+					streamed.append(chars.data(), encoder.Update(chars.data(), bytes.data() + i, PHANTASMA_MIN(piece, length - i)));
+				streamed.append(chars.data(), encoder.Final(chars.data()));
+				streamOk &= streamed == encoded;
+			}
+
+			for( int piece : { 7, 66, 128, 131 } )
+			{
+				Base64::Decoder decoder;
+				ByteArray back;
+				std::vector<Byte> out(Base64::Decoder::MaxUpdateBytes(piece));
+				for( int i = 0; i < (int)encoded.size(); i += piece )
+				{
+					const int written = decoder.Update(out.data(), encoded.c_str() + i, PHANTASMA_MIN(piece, (int)encoded.size() - i));
+					back.insert(back.end(), out.begin(), out.begin() + written);
+				}
+				streamOk &= decoder.Final() == 0 && back == bytes;
+			}
+		}
+		Report(ctx, blocksOk, "Base64 block codec matches scalar");
+		Report(ctx, streamOk, "Base64 streaming codec matches one-shot");
+
+		ExpectThrowContains(ctx, "Base64 stream rejects data after padding", "Invalid input", []
+		    {
+			    Base64::Decoder decoder;
+			    Byte out[8];
+			    decoder.Update(out, "QQ==QUJD", 8);
+		    });
+		ExpectThrowContains(ctx, "Base64 stream rejects a partial group", "Invalid input", []
+		    {
+			    Base64::Decoder decoder;
+			    Byte out[8];
+			    decoder.Update(out, "QUJ", 3);
+			    decoder.Final();
+		    });
+	}
 }
 
 } // namespace testcases
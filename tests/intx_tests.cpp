@@ -3,6 +3,49 @@
 namespace testcases {
 using namespace testutil;
 
+namespace {
+
+bool TryOpenFixture(std::ifstream& file, const char* name)
+{
+	file.open(std::string("tests/fixtures/") + name);
+	if( !file.is_open() )
+	{
+		file.open(std::string("fixtures/") + name);
+	}
+	return file.is_open();
+}
+
+// Fixture values are 64 hex digits, most significant first
+uint256 ParseHex256(const std::string& hex)
+{
+	ByteArray bytes = HexToBytes(hex);
+	std::reverse(bytes.begin(), bytes.end());
+	return uint256::FromBytes(ByteView{ bytes.data(), bytes.size() });
+}
+
+std::string Hex256(const uint256& value)
+{
+	ByteArray bytes(32);
+	memcpy(bytes.data(), &value, 32);
+	std::reverse(bytes.begin(), bytes.end());
+	return BytesToHex(bytes);
+}
+
+// Compile-time evaluation of the constexpr arithmetic
+constexpr uint256 OneEther = uint256(10).Pow(uint256(18));
+static_assert(OneEther == uint256(1000000000000000000ULL));
+static_assert(uint256(10).Pow(uint256(0)) == uint256(1));
+static_assert(((uint256(1) << 255) >> 255) == uint256(1));
+constexpr uint256 MaxWordSquared = uint256(~0ULL) * uint256(~0ULL);
+static_assert(MaxWordSquared == (uint256(1) << 128) - (uint256(1) << 65) + uint256(1));
+static_assert(uint256(0) - uint256(1) == ~uint256(0));
+static_assert(int256(-5) * int256(3) == int256(-15));
+static_assert(-int256(7) < int256(0) && int256(-7).Abs() == int256(7));
+static_assert((int64_t)int256(INT64_MIN) == INT64_MIN && int256(INT64_MIN).Is8ByteSafe());
+static_assert(!(uint256(1) << 64).Is8ByteSafe() && (uint64_t)(uint256(1) << 64) == UINT64_MAX);
+
+} // namespace
+
 void RunIntXIs8ByteSafeTests(TestContext& ctx)
 {
 	const intx zero((int64_t)0);
@@ -21,4 +64,150 @@ void RunIntXIs8ByteSafeTests(TestContext& ctx)
 	Report(ctx, bigBacked.Int256().Is8ByteSafe(), "IntX safe big-backed");
 }
 
+void RunIntXArithmeticTests(TestContext& ctx)
+{
+	const int64_t edges[] = { 0, 1, -1, 2, -2, 3, 1000000007, -1000000007, INT32_MAX, INT32_MIN, (int64_t)1 << 32,
+		-((int64_t)1 << 32), INT64_MAX, INT64_MAX - 1, INT64_MIN, INT64_MIN + 1, 3037000499LL, -3037000499LL, 3037000500LL };
+	bool matches = true;
+	bool smallStaysSmall = true;
+	for( int64_t x : edges )
+	{
+		for( int64_t y : edges )
+		{
+			const intx a(x), b(y);
+			const int256 wa(x), wb(y);
+			matches &= (a + b).Int256() == wa + wb;
+			matches &= (a - b).Int256() == wa - wb;
+			matches &= (a * b).Int256() == wa * wb;
+			if( y != 0 )
+				matches &= (a / b).Int256() == wa / wb;
+			matches &= a.Compare(b) == wa.Compare(wb);
+			matches &= (a == b) == (x == y) && (a < b) == (x < y) && (a >= b) == (x >= y);
+			int64_t r;
+			if( !__builtin_add_overflow(x, y, &r) )
+				smallStaysSmall &= !(a + b).isBig;
+			if( !__builtin_mul_overflow(x, y, &r) )
+				smallStaysSmall &= !(a * b).isBig;
+		}
+	}
+	Report(ctx, matches, "IntX small arithmetic matches int256");
+	Report(ctx, smallStaysSmall, "IntX small arithmetic stays in int64");
+	const intx a(INT64_MAX), b(INT64_MIN), one(1);
+	Report(ctx, !a.isBig && !b.isBig, "IntX small operands are not promoted");
+
+	const intx overflow = a + one;
+	Report(ctx, overflow.isBig && overflow.ToString() == "9223372036854775808", "IntX add promotes on overflow");
+	Report(ctx, (b - one).ToString() == "-9223372036854775809", "IntX sub promotes on overflow");
+	Report(ctx, (b / intx(-1)).ToString() == "9223372036854775808", "IntX div promotes min/-1");
+	Report(ctx, (a * a).ToString() == "85070591730234615847396907784232501249", "IntX mul promotes on overflow");
+
+	const intx back = overflow - one;
+	Report(ctx, !back.isBig && (int64_t)back == INT64_MAX, "IntX wide result that fits returns to int64");
+	Report(ctx, overflow > a && a < overflow && overflow != a, "IntX compares mixed forms");
+	Report(ctx, intx(uint256(7)) == intx(7) && intx(int256(-7)) < intx(0), "IntX compares big-backed small values");
+
+	intx sum(0);
+	for( int i = 0; i != 10; ++i )
+		sum += intx(INT64_MAX);
+	sum -= intx(INT64_MAX);
+	sum *= intx(2);
+	sum /= intx(9);
+	Report(ctx, sum.ToString() == "18446744073709551614", "IntX compound assignment across the overflow boundary");
+}
+
+void RunInt256OpFixtureTests(TestContext& ctx)
+{
+	// Fixture: carbon_int256_ops.tsv, recorded from the tiny-bignum-c backend that Int256Impl.h replaced, so these rows pin
+	// the new kernels to the old results rather than to an external reference.
+	// Columns: a, b, shift, exp, add, sub, mul, div, mod, sdiv, smul, shl, shr, cmp, scmp, pow, sqrt, dec, sdec, hex.
+	std::ifstream file;
+	if( !TryOpenFixture(file, "carbon_int256_ops.tsv") )
+	{
+		Report(ctx, false, "Int256 ops fixture", "missing carbon_int256_ops.tsv");
+		return;
+	}
+
+	std::string line;
+	std::getline(file, line);
+	int rows = 0;
+	while( std::getline(file, line) )
+	{
+		std::vector<std::string> cols;
+		std::stringstream ss(line);
+		std::string col;
+		while( std::getline(ss, col, '\t') )
+			cols.push_back(col);
+		if( cols.size() < 20 )
+			continue;
+		++rows;
+
+		const uint256 a = ParseHex256(cols[0]);
+		const uint256 b = ParseHex256(cols[1]);
+		const int shift = std::stoi(cols[2]);
+		const uint64_t exp = std::stoull(cols[3]);
+		const int256 sa(a);
+		const int256 sb(b);
+		const std::string name = "Int256 ops row " + std::to_string(rows);
+
+		Report(ctx, Hex256(a + b) == cols[4], name + " add");
+		Report(ctx, Hex256(a - b) == cols[5], name + " sub");
+		Report(ctx, Hex256(a * b) == cols[6], name + " mul");
+		if( cols[7] != "-" )
+		{
+			Report(ctx, Hex256(a / b) == cols[7], name + " div");
+			Report(ctx, Hex256(a % b) == cols[8], name + " mod");
+			Report(ctx, Hex256((sa / sb).Unsigned()) == cols[9], name + " signed div");
+		}
+		Report(ctx, Hex256((sa * sb).Unsigned()) == cols[10], name + " signed mul");
+		Report(ctx, Hex256(a << shift) == cols[11], name + " shl");
+		Report(ctx, Hex256(a >> shift) == cols[12], name + " shr");
+		Report(ctx, a.Compare(b) == std::stoi(cols[13]), name + " cmp");
+		Report(ctx, sa.Compare(sb) == std::stoi(cols[14]), name + " signed cmp");
+		Report(ctx, Hex256(a.Pow(uint256(exp))) == cols[15], name + " pow");
+		Report(ctx, Hex256(a.Sqrt()) == cols[16], name + " sqrt");
+		Report(ctx, a.ToString() == cols[17], name + " decimal");
+		Report(ctx, sa.ToString() == cols[18], name + " signed decimal");
+		Report(ctx, a.ToString(16) == cols[19], name + " hex");
+
+		uint256 compound = a;
+		compound *= b;
+		compound += a;
+		compound -= b;
+		Report(ctx, compound == a * b + a - b, name + " compound assignment");
+	}
+	Report(ctx, rows > 0, "Int256 ops fixture rows");
+
+	// The same expressions evaluated at run time take the intrinsic code paths
+	volatile uint64_t ten = 10;
+	volatile uint64_t all = ~0ULL;
+	Report(ctx, uint256(ten).Pow(uint256(18)) == OneEther, "Int256 constexpr pow matches run time");
+	Report(ctx, uint256(all) * uint256(all) == MaxWordSquared, "Int256 constexpr mul matches run time");
+	Report(ctx, (uint256(all) << 64) - uint256(all) == MaxWordSquared, "Int256 constexpr shift/add/sub match run time");
+
+	// Quotient and remainder identities over divisors of every limb length, to reach the quotient correction steps
+	uint64_t state = 0x9E3779B97F4A7C15ULL;
+	auto next = [&state]()
+	{
+		state ^= state << 13;
+		state ^= state >> 7;
+		state ^= state << 17;
+		return state;
+	};
+	bool identities = true;
+	for( int i = 0; i != 2000 && identities; ++i )
+	{
+		const uint256 a = (uint256(next()) << 192) | (uint256(next()) << 128) | (uint256(next()) << 64) | uint256(next());
+		uint256 b = (uint256(next()) << 192) | (uint256(next()) << 128) | (uint256(next()) << 64) | uint256(next());
+		b >>= (int)(next() % 256);
+		if( i % 3 == 0 )
+			b = (a >> (int)(next() % 129)) - uint256(next() % 3); // shares the dividend's top bits, so estimates overshoot
+		if( !b )
+			continue;
+		const uint256 q = a / b;
+		const uint256 r = a % b;
+		identities = r < b && q * b + r == a;
+	}
+	Report(ctx, identities, "Int256 division identities");
+}
+
 } // namespace testcases
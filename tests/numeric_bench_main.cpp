@@ -0,0 +1,458 @@
+#define PHANTASMA_IMPLEMENTATION
+#include "test_common.h"
+
+#include <chrono>
+#include <map>
+#include <type_traits>
+
+// Replays the arithmetic fixture corpora through BigInteger, uint256, int256 and intx and reports ns/op per
+// operation. Results are written as JSON, one result object per line, and can be compared against a saved baseline.
+//
+// usage: numeric_bench [--json <out>] [--baseline <file>] [--save-baseline <file>] [--threshold <percent>]
+//                      [--min-time <ms>]
+
+using namespace testutil;
+
+namespace {
+
+struct Operands {
+	std::string a;
+	std::string b;
+	int shift;
+};
+
+struct Result {
+	std::string type;
+	std::string corpus;
+	std::string op;
+	uint64_t ops;
+	double nsPerOp;
+};
+
+struct Options {
+	std::string jsonPath;
+	std::string baselinePath;
+	std::string saveBaselinePath;
+	double thresholdPercent = 15.0;
+	int minTimeMs = 50;
+};
+
+bool TryOpenFixture(std::ifstream& file, const char* name)
+{
+	file.open(std::string("tests/fixtures/") + name);
+	if( !file.is_open() )
+	{
+		file.open(std::string("fixtures/") + name);
+	}
+	return file.is_open();
+}
+
+std::vector<std::string> SplitTabs(const std::string& line)
+{
+	std::vector<std::string> cols;
+	std::stringstream ss(line);
+	std::string col;
+	while( std::getline(ss, col, '\t') )
+		cols.push_back(col);
+	return cols;
+}
+
+// Operands are kept as normalized decimal text so every type parses the same values
+std::string Normalize(const std::string& dec)
+{
+	const String s = BigInteger::Parse(String(dec.begin(), dec.end())).ToString();
+	return std::string(s.begin(), s.end());
+}
+
+uint256 FromHex(const std::string& hex)
+{
+	ByteArray bytes = HexToBytes(hex);
+	std::reverse(bytes.begin(), bytes.end());
+	return uint256::FromBytes(ByteView{ bytes.data(), bytes.size() });
+}
+
+bool LoadCorpus(std::vector<Operands>& out)
+{
+	std::ifstream file;
+	std::string line;
+
+	// a, b, shift, cmp, add, sub, mul, div, mod, shl, shr
+	if( !TryOpenFixture(file, "phantasma_bigint_ops.tsv") )
+	{
+		std::cerr << "missing phantasma_bigint_ops.tsv" << std::endl;
+		return false;
+	}
+	std::getline(file, line);
+	while( std::getline(file, line) )
+	{
+		const std::vector<std::string> cols = SplitTabs(line);
+		if( cols.size() >= 3 )
+			out.push_back({ Normalize(cols[0]), Normalize(cols[1]), std::stoi(cols[2]) });
+	}
+	file.close();
+
+	// case_id, op, a, b, outcome, ...; only the arithmetic rows that succeed
+	if( !TryOpenFixture(file, "gen2_csharp_vm_bigint_ops.tsv") )
+	{
+		std::cerr << "missing gen2_csharp_vm_bigint_ops.tsv" << std::endl;
+		return false;
+	}
+	bool header = true;
+	while( std::getline(file, line) )
+	{
+		if( line.empty() || line[0] == '#' )
+			continue;
+		if( header )
+		{
+			header = false;
+			continue;
+		}
+		const std::vector<std::string> cols = SplitTabs(line);
+		if( cols.size() < 5 || cols[4] != "ok" )
+			continue;
+		const std::string& op = cols[1];
+		if( op == "ADD" || op == "SUB" || op == "MUL" || op == "DIV" || op == "MOD" )
+			out.push_back({ Normalize(cols[2]), Normalize(cols[3]), 1 });
+	}
+	file.close();
+
+	// a, b, shift, ...; 64 hex digits, read as two's complement
+	if( !TryOpenFixture(file, "carbon_int256_ops.tsv") )
+	{
+		std::cerr << "missing carbon_int256_ops.tsv" << std::endl;
+		return false;
+	}
+	std::getline(file, line);
+	while( std::getline(file, line) )
+	{
+		const std::vector<std::string> cols = SplitTabs(line);
+		if( cols.size() < 3 )
+			continue;
+		const uint256 a = FromHex(cols[0]);
+		const uint256 b = FromHex(cols[1]);
+		out.push_back({ a.Signed().ToString(), b.Signed().ToString(), std::stoi(cols[2]) });
+	}
+	return !out.empty();
+}
+
+bool FitsInt256(const Operands& o)
+{
+	const int bits = 255;
+	return BigInteger::Parse(String(o.a.begin(), o.a.end())).GetBitLength() <= bits &&
+	       BigInteger::Parse(String(o.b.begin(), o.b.end())).GetBitLength() <= bits && o.shift >= 0 && o.shift < 256;
+}
+
+// Makes value look used to the optimizer, so the benchmarked work that produced it is not discarded
+inline void Escape(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r"(value) : "memory");
+#else
+	static volatile uint64_t keep;
+	keep = value;
+	(void)keep;
+#endif
+}
+
+// Runs body(i) over every operand index until at least minTimeMs has elapsed, and keeps the best of a few rounds
+template<typename Fn>
+Result Measure(const Options& opt, const char* type, const char* corpus, const char* op, size_t count, Fn&& body)
+{
+	using Clock = std::chrono::steady_clock;
+	const auto minTime = std::chrono::milliseconds(opt.minTimeMs);
+	uint64_t sink = 0;
+	uint64_t totalOps = 0;
+	double best = 0;
+	for( int round = 0; round != 3; ++round )
+	{
+		uint64_t ops = 0;
+		const auto start = Clock::now();
+		Clock::duration elapsed;
+		do
+		{
+			for( size_t i = 0; i != count; ++i )
+				sink += body(i);
+			ops += count;
+			elapsed = Clock::now() - start;
+		} while( elapsed < minTime );
+		const double ns = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / (double)ops;
+		if( round == 0 || ns < best )
+			best = ns;
+		totalOps += ops;
+	}
+	Escape(sink);
+	return { type, corpus, op, totalOps, best };
+}
+
+uint64_t Low(const BigInteger& v)
+{
+	return v.IsZero() ? 0 : (uint64_t)v.GetBitLength();
+}
+
+uint64_t Low(const uint256& v)
+{
+	return (uint64_t)v;
+}
+
+uint64_t Low(const int256& v)
+{
+	return (uint64_t)v.Unsigned();
+}
+
+uint64_t Low(const intx& v)
+{
+	return (uint64_t)v;
+}
+
+void BenchBigInteger(const Options& opt, const char* corpus, const std::vector<Operands>& rows, std::vector<Result>& out)
+{
+	std::vector<String> textA, textB;
+	std::vector<BigInteger> a, b, divisors, dividends;
+	std::vector<int> shifts;
+	for( const Operands& o : rows )
+	{
+		textA.emplace_back(o.a.begin(), o.a.end());
+		textB.emplace_back(o.b.begin(), o.b.end());
+		a.push_back(BigInteger::Parse(textA.back()));
+		b.push_back(BigInteger::Parse(textB.back()));
+		shifts.push_back(o.shift);
+		if( !b.back().IsZero() )
+		{
+			dividends.push_back(a.back());
+			divisors.push_back(b.back());
+		}
+	}
+	const size_t n = rows.size();
+	out.push_back(Measure(opt, "BigInteger", corpus, "parse", n, [&](size_t i) { return Low(BigInteger::Parse(textA[i])); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "to_string", n, [&](size_t i) { return (uint64_t)a[i].ToString().size(); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "cmp", n, [&](size_t i) { return (uint64_t)(a[i].CompareTo(b[i]) + 1); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "add", n, [&](size_t i) { return Low(a[i] + b[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "sub", n, [&](size_t i) { return Low(a[i] - b[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "mul", n, [&](size_t i) { return Low(a[i] * b[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "div", divisors.size(), [&](size_t i) { return Low(dividends[i] / divisors[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "mod", divisors.size(), [&](size_t i) { return Low(dividends[i] % divisors[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "shl", n, [&](size_t i) { return Low(a[i] << shifts[i]); }));
+	out.push_back(Measure(opt, "BigInteger", corpus, "shr", n, [&](size_t i) { return Low(a[i] >> shifts[i]); }));
+}
+
+template<typename T>
+T FromDecimal(const std::string& dec);
+
+template<>
+uint256 FromDecimal<uint256>(const std::string& dec)
+{
+	return uint256::FromString(dec.c_str());
+}
+
+template<>
+int256 FromDecimal<int256>(const std::string& dec)
+{
+	return uint256::FromString(dec.c_str()).Signed();
+}
+
+template<typename T>
+void BenchFixed(const Options& opt, const char* type, const char* corpus, const std::vector<Operands>& rows, std::vector<Result>& out)
+{
+	std::vector<T> a, b, divisors, dividends;
+	std::vector<int> shifts;
+	for( const Operands& o : rows )
+	{
+		a.push_back(FromDecimal<T>(o.a));
+		b.push_back(FromDecimal<T>(o.b));
+		shifts.push_back(o.shift);
+		if( !!b.back() )
+		{
+			dividends.push_back(a.back());
+			divisors.push_back(b.back());
+		}
+	}
+	const size_t n = rows.size();
+	out.push_back(Measure(opt, type, corpus, "parse", n, [&](size_t i) { return Low(FromDecimal<T>(rows[i].a)); }));
+	out.push_back(Measure(opt, type, corpus, "to_string", n, [&](size_t i) { return (uint64_t)a[i].ToString().size(); }));
+	out.push_back(Measure(opt, type, corpus, "cmp", n, [&](size_t i) { return (uint64_t)(a[i].Compare(b[i]) + 1); }));
+	out.push_back(Measure(opt, type, corpus, "add", n, [&](size_t i) { return Low(a[i] + b[i]); }));
+	out.push_back(Measure(opt, type, corpus, "sub", n, [&](size_t i) { return Low(a[i] - b[i]); }));
+	out.push_back(Measure(opt, type, corpus, "mul", n, [&](size_t i) { return Low(a[i] * b[i]); }));
+	out.push_back(Measure(opt, type, corpus, "div", divisors.size(), [&](size_t i) { return Low(dividends[i] / divisors[i]); }));
+	out.push_back(Measure(opt, type, corpus, "shl", n, [&](size_t i) { return Low(a[i] << shifts[i]); }));
+	// int256 declares % and >> but only uint256 defines them
+	if constexpr( std::is_same<T, uint256>::value )
+	{
+		out.push_back(Measure(opt, type, corpus, "mod", divisors.size(), [&](size_t i) { return Low(dividends[i] % divisors[i]); }));
+		out.push_back(Measure(opt, type, corpus, "shr", n, [&](size_t i) { return Low(a[i] >> shifts[i]); }));
+	}
+}
+
+// intx has no remainder or shift operators
+void BenchIntx(const Options& opt, const char* corpus, const std::vector<Operands>& rows, std::vector<Result>& out)
+{
+	std::vector<intx> a, b, divisors, dividends;
+	for( const Operands& o : rows )
+	{
+		a.push_back(intx::FromString(o.a.c_str()));
+		b.push_back(intx::FromString(o.b.c_str()));
+		if( !!b.back() )
+		{
+			dividends.push_back(a.back());
+			divisors.push_back(b.back());
+		}
+	}
+	const size_t n = rows.size();
+	out.push_back(Measure(opt, "intx", corpus, "parse", n, [&](size_t i) { return Low(intx::FromString(rows[i].a.c_str())); }));
+	out.push_back(Measure(opt, "intx", corpus, "to_string", n, [&](size_t i) { return (uint64_t)a[i].ToString().size(); }));
+	out.push_back(Measure(opt, "intx", corpus, "cmp", n, [&](size_t i) { return (uint64_t)(a[i].Compare(b[i]) + 1); }));
+	out.push_back(Measure(opt, "intx", corpus, "add", n, [&](size_t i) { return Low(a[i] + b[i]); }));
+	out.push_back(Measure(opt, "intx", corpus, "sub", n, [&](size_t i) { return Low(a[i] - b[i]); }));
+	out.push_back(Measure(opt, "intx", corpus, "mul", n, [&](size_t i) { return Low(a[i] * b[i]); }));
+	out.push_back(Measure(opt, "intx", corpus, "div", divisors.size(), [&](size_t i) { return Low(dividends[i] / divisors[i]); }));
+}
+
+std::string Key(const Result& r)
+{
+	return r.type + "/" + r.corpus + "/" + r.op;
+}
+
+bool WriteJson(const std::string& path, const std::vector<Result>& results)
+{
+	std::ofstream file(path);
+	if( !file.is_open() )
+	{
+		std::cerr << "cannot write " << path << std::endl;
+		return false;
+	}
+	file << "{\n\t\"results\": [\n";
+	for( size_t i = 0; i != results.size(); ++i )
+	{
+		const Result& r = results[i];
+		char ns[32];
+		snprintf(ns, sizeof(ns), "%.2f", r.nsPerOp);
+		file << "\t\t{ \"type\": \"" << r.type << "\", \"corpus\": \"" << r.corpus << "\", \"op\": \"" << r.op
+		     << "\", \"ops\": " << r.ops << ", \"ns_per_op\": " << ns << " }" << (i + 1 != results.size() ? "," : "") << "\n";
+	}
+	file << "\t]\n}\n";
+	return true;
+}
+
+bool ReadStringField(const std::string& line, const char* field, std::string& value)
+{
+	const std::string key = std::string("\"") + field + "\": \"";
+	const size_t start = line.find(key);
+	if( start == std::string::npos )
+		return false;
+	const size_t end = line.find('"', start + key.size());
+	if( end == std::string::npos )
+		return false;
+	value = line.substr(start + key.size(), end - start - key.size());
+	return true;
+}
+
+// Reads back the one-result-per-line layout written by WriteJson
+bool ReadBaseline(const std::string& path, std::map<std::string, double>& out)
+{
+	std::ifstream file(path);
+	if( !file.is_open() )
+		return false;
+	std::string line;
+	while( std::getline(file, line) )
+	{
+		Result r;
+		const char* nsKey = "\"ns_per_op\": ";
+		const size_t ns = line.find(nsKey);
+		if( ns == std::string::npos || !ReadStringField(line, "type", r.type) || !ReadStringField(line, "corpus", r.corpus) ||
+		    !ReadStringField(line, "op", r.op) )
+			continue;
+		out[Key(r)] = std::strtod(line.c_str() + ns + strlen(nsKey), nullptr);
+	}
+	return true;
+}
+
+bool ParseArgs(int argc, char** argv, Options& opt)
+{
+	for( int i = 1; i < argc; ++i )
+	{
+		const std::string arg = argv[i];
+		if( i + 1 >= argc )
+		{
+			std::cerr << "missing value for " << arg << std::endl;
+			return false;
+		}
+		const char* value = argv[++i];
+		if( arg == "--json" )
+			opt.jsonPath = value;
+		else if( arg == "--baseline" )
+			opt.baselinePath = value;
+		else if( arg == "--save-baseline" )
+			opt.saveBaselinePath = value;
+		else if( arg == "--threshold" )
+			opt.thresholdPercent = std::atof(value);
+		else if( arg == "--min-time" )
+			opt.minTimeMs = std::atoi(value);
+		else
+		{
+			std::cerr << "unknown option " << arg << std::endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+	Options opt;
+	if( !ParseArgs(argc, argv, opt) )
+		return 2;
+
+	std::vector<Operands> full;
+	if( !LoadCorpus(full) )
+		return 2;
+	std::vector<Operands> fixed;
+	for( const Operands& o : full )
+	{
+		if( FitsInt256(o) )
+			fixed.push_back(o);
+	}
+
+	// "int256" is the subset every type can represent and is the one to compare types on; "full" is every operand,
+	// including the ones wider than 256 bits, and is only meaningful for BigInteger.
+	std::vector<Result> results;
+	BenchBigInteger(opt, "full", full, results);
+	BenchBigInteger(opt, "int256", fixed, results);
+	BenchFixed<uint256>(opt, "uint256", "int256", fixed, results);
+	BenchFixed<int256>(opt, "int256", "int256", fixed, results);
+	BenchIntx(opt, "int256", fixed, results);
+
+	std::map<std::string, double> baseline;
+	const bool haveBaseline = !opt.baselinePath.empty() && ReadBaseline(opt.baselinePath, baseline);
+	if( !opt.baselinePath.empty() && !haveBaseline )
+		std::cout << "No baseline at " << opt.baselinePath << ", skipping comparison." << std::endl;
+
+	int regressions = 0;
+	printf("%-12s %-8s %-10s %12s %10s\n", "type", "corpus", "op", "ns/op", "vs base");
+	for( const Result& r : results )
+	{
+		printf("%-12s %-8s %-10s %12.2f", r.type.c_str(), r.corpus.c_str(), r.op.c_str(), r.nsPerOp);
+		const auto base = baseline.find(Key(r));
+		if( base != baseline.end() && base->second > 0 )
+		{
+			const double change = (r.nsPerOp / base->second - 1.0) * 100.0;
+			const bool regressed = change > opt.thresholdPercent;
+			printf(" %+9.1f%%%s", change, regressed ? "  REGRESSION" : "");
+			regressions += regressed ? 1 : 0;
+		}
+		printf("\n");
+	}
+
+	if( !opt.jsonPath.empty() && !WriteJson(opt.jsonPath, results) )
+		return 2;
+	if( !opt.saveBaselinePath.empty() && !WriteJson(opt.saveBaselinePath, results) )
+		return 2;
+
+	if( regressions != 0 )
+	{
+		std::cerr << regressions << " operations are more than " << opt.thresholdPercent << "% slower than the baseline." << std::endl;
+		return 1;
+	}
+	return 0;
+}
@@ -46,6 +46,50 @@ void RunScriptBuilderTransactionTests(TestContext& ctx)
 	    knownTx.Signatures().size() == 1;
 	Report(ctx, knownOk, "Transaction unserialize");
 
+	{
+		// The cached signing message follows every change to the signed fields
+		const auto serializeUnsigned = [](const Transaction& t)
+		{
+			BinaryWriter writer;
+			t.Serialize(writer, false);
+			return writer.ToArray();
+		};
+		Transaction mined("testnet", "main", script, expiration, payload);
+		const ByteArray before = mined.UnsignedBytes();
+		mined.Mine(8);
+		const ByteArray after = serializeUnsigned(mined);
+		const bool cacheOk = before != after && mined.UnsignedBytes() == after && mined.ToByteArray(false) == after &&
+		                     mined.GetHash() == Hash(SHA256(after)) && mined.GetHash().GetDifficulty() >= 8 &&
+		                     knownTx.UnsignedBytes() == serializeUnsigned(knownTx);
+		Report(ctx, cacheOk, "Transaction caches its unsigned bytes");
+		const Transaction empty;
+		Report(ctx, empty.UnsignedBytes() == serializeUnsigned(empty) && empty.ToByteArray(false) == serializeUnsigned(empty),
+		    "Default constructed transaction has its unsigned bytes");
+
+		// Payload sizes put the nonce at different offsets within the last hash blocks
+		bool threadsOk = true;
+		for( int extra = 0; extra < 70; extra += 23 )
+		{
+			ByteArray longPayload(payload);
+			longPayload.resize(payload.size() + extra, 0x5A);
+			Transaction single("testnet", "main", script, expiration, longPayload);
+			Transaction parallel("testnet", "main", script, expiration, longPayload);
+			single.Mine(12, 1);
+			parallel.Mine(12, 3);
+			threadsOk &= parallel.GetHash().GetDifficulty() >= 12 && single.GetHash() == parallel.GetHash() &&
+			             single.Payload() == parallel.Payload();
+		}
+		Report(ctx, threadsOk, "Transaction mining is independent of the thread count");
+
+		Byte zeroBits[Hash::Length] = {};
+		zeroBits[27] = 0x10;
+		Report(ctx, Hash::Difficulty(zeroBits) == 35 && Hash().GetDifficulty() == 256, "Hash difficulty counts leading zero bits");
+
+		const Address candidates[] = { otherKeys.GetAddress(), keys.GetAddress() };
+		Report(ctx, tx.IsSignedBy(candidates, 2) && tx.IsSignedBy(keys.GetAddress()) && !tx.IsSignedBy(otherKeys.GetAddress()),
+		    "Transaction signed by candidates");
+	}
+
 	TokenEventData tokenEvent("KCAL", BigInteger(42), "main");
 	BinaryWriter tokenWriter;
 	tokenWriter.WriteSerializable(tokenEvent);
@@ -27,10 +27,18 @@ void RunBigIntConstructorTests(testutil::TestContext& ctx);
 void RunBigIntOperatorTests(testutil::TestContext& ctx);
 void RunSecureBigIntTests(testutil::TestContext& ctx);
 void RunBigIntMultiWordTests(testutil::TestContext& ctx);
+void RunBigIntInlineStorageTests(testutil::TestContext& ctx);
+void RunBigIntWideArithmeticTests(testutil::TestContext& ctx);
+void RunBigIntLongRadixConversionTests(testutil::TestContext& ctx);
+void RunBigIntInPlaceArithmeticTests(testutil::TestContext& ctx);
 void RunIntXIs8ByteSafeTests(testutil::TestContext& ctx);
+void RunIntXArithmeticTests(testutil::TestContext& ctx);
+void RunInt256OpFixtureTests(testutil::TestContext& ctx);
 void RunTokenBuilderValidationTests(testutil::TestContext& ctx);
 void RunEncodingRoundtripTests(testutil::TestContext& ctx);
 void RunKeyPairTests(testutil::TestContext& ctx);
 void RunCarbonTxExtraTests(testutil::TestContext& ctx);
+void RunAllocatorTests(testutil::TestContext& ctx);
+void RunCarbonTxReadTests(testutil::TestContext& ctx);
 
 } // namespace testcases
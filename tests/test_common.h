@@ -19,6 +19,7 @@
 #include "../include/Carbon/Carbon.h"
 #include "../include/Carbon/DataBlockchain.h"
 #include "../include/Carbon/Tx.h"
+#include "../include/Carbon/TxBatch.h"
 #include "../include/Carbon/Contracts/Token.h"
 #include "../include/Carbon/Contracts/TokenSchemas.h"
 #include "../include/Carbon/DataVm.h"
@@ -28,8 +28,16 @@ int main()
 	testcases::RunBigIntOperatorTests(ctx);
 	testcases::RunSecureBigIntTests(ctx);
 	testcases::RunBigIntMultiWordTests(ctx);
+	testcases::RunBigIntInlineStorageTests(ctx);
+	testcases::RunBigIntWideArithmeticTests(ctx);
+	testcases::RunBigIntLongRadixConversionTests(ctx);
+	testcases::RunBigIntInPlaceArithmeticTests(ctx);
 	testcases::RunIntXIs8ByteSafeTests(ctx);
+	testcases::RunIntXArithmeticTests(ctx);
+	testcases::RunInt256OpFixtureTests(ctx);
 	testcases::RunCallSectionsTests(ctx);
+	testcases::RunAllocatorTests(ctx);
+	testcases::RunCarbonTxReadTests(ctx);
 
 	if( ctx.failed == 0 )
 	{